@@ -13,6 +13,7 @@ BuildRequires:  pkgconfig(syspopup)
 BuildRequires:  pkgconfig(dlog)
 BuildRequires:  pkgconfig(svi)
 BuildRequires:  pkgconfig(ui-gadget-1)
+BuildRequires:  pkgconfig(vconf-internal-keys)
 
 BuildRequires:  cmake
 BuildRequires:  edje-bin
@@ -22,6 +23,14 @@ BuildRequires:  gettext-devel
 %description
 volume.
 
+%package devel
+Summary:	Reader for the volume state published by %{name}
+Group:	TO_BE/FILLED_IN
+Requires:	%{name} = %{version}-%{release}
+
+%description devel
+Static library and header to read the volume state published by %{name}.
+
 %prep
 %setup -q
 
@@ -43,3 +52,8 @@ rm -rf %{buildroot}
 %{PREFIX}/res/*
 /opt/share/packages/org.tizen.volume.xml
 /opt/share/icons/default/small/org.tizen.volume.png
+
+%files devel
+%defattr(-,root,root,-)
+%{PREFIX}/include/volume_state.h
+%{PREFIX}/lib/libvolume-state.a
@@ -0,0 +1,27 @@
+#!/bin/sh
+#
+# Check the allocation profile of a replayed workload.
+#
+# usage: alloc-check.sh <alloc tsv>
+#
+# The app appends the running totals on every hide, the last line of a
+# phase is its total. Exits 1 when a phase ran over its budget.
+
+if [ $# -ne 1 ] || [ ! -f "$1" ]; then
+	echo "usage: $0 <alloc tsv>" >&2
+	exit 1
+fi
+
+echo "phase	runs	allocs	bytes	first	steady	budget	result"
+awk -F'\t' '
+	!($2 in row) { order[n++] = $2 }
+	{ row[$2] = $0; result[$2] = $9 }
+	END {
+		for (i = 0; i < n; i++) {
+			split(row[order[i]], f, "\t")
+			printf "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n", f[2], f[3], f[4], f[5], f[6], f[7], f[8], f[9]
+			if (result[order[i]] == "over")
+				over++
+		}
+		exit over ? 1 : 0
+	}' "$1"
@@ -0,0 +1,64 @@
+#!/bin/sh
+#
+# Loader work and memory of a launch, before and after a change.
+#
+# usage: load-report.sh <before build dir> <after build dir>
+#
+# Each directory holds the "volume" binary and pgo/launch.rec. Run on
+# the target: both binaries replay the cold and warm launch of
+# launch.txt on the simulated backend, the dynamic loader reports its
+# statistics (LD_DEBUG=statistics) and /proc is sampled for the peak
+# and last resident size and for the lazily opened libraries mapped.
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 <before build dir> <after build dir>" >&2
+	exit 1
+fi
+
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+# prints: loader startup cycles, relocations at startup, relative ones,
+# relocations at exit (dlopen included), VmHWM kB, VmRSS kB, lazily
+# opened libraries mapped
+measure() {
+	rm -f "$tmp"/ld.*
+	env VOLUME_BACKEND=sim VOLUME_REPLAY="$1/pgo/launch.rec" \
+		VOLUME_REPLAY_EXIT=1 LD_DEBUG=statistics \
+		LD_DEBUG_OUTPUT="$tmp/ld" "$1/volume" >/dev/null 2>&1 &
+	pid=$!
+	hwm=0
+	rss=0
+	libs=
+	while kill -0 $pid 2>/dev/null; do
+		s=$(awk '/^VmHWM:/ { h = $2 } /^VmRSS:/ { r = $2 }
+			END { print h + 0, r + 0 }' /proc/$pid/status 2>/dev/null)
+		case "$s" in
+		""|"0 "*)
+			# exiting, keep the last sample
+			;;
+		*)
+			hwm=${s% *}
+			rss=${s#* }
+			libs=$(grep -oE 'lib(svi|ui-gadget-1)\.so[.0-9]*' \
+				/proc/$pid/maps 2>/dev/null | sort -u | tr '\n' ' ')
+			;;
+		esac
+		sleep 0.05
+	done
+	wait $pid
+	cat "$tmp"/ld.* 2>/dev/null | awk -v hwm="$hwm" -v rss="$rss" -v libs="$libs" '
+		/total startup time in dynamic loader/ { cyc = $(NF - 1) }
+		/final number of relocations:/ { fin = $NF; next }
+		/number of relocations:/ { rel = $NF }
+		/number of relative relocations:/ { rrel = $NF }
+		END {
+			printf "%s\t%s\t%s\t%s\t%s\t%s\t%s\n", cyc, rel, rrel, fin,
+				hwm, rss, libs == "" ? "-" : libs
+		}'
+}
+
+printf "build\tcycles\trelocs\trelative\tat exit\tVmHWM\tVmRSS\tlazy libs\n"
+for d in "$1" "$2"; do
+	printf "%s\t%s\n" "$d" "$(measure "$d")"
+done
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * mktrain: turn a readable input script into a record file that the
+ * app replays with VOLUME_REPLAY, see src/_record.h for the layout.
+ *
+ * usage: mktrain <output> <script>
+ *
+ * Script lines are "<msec> <input> <argument>", '#' starts a comment.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "_record.h"
+
+#define LINE_MAX_LEN 256
+
+struct name {
+	const char *name;
+	int value;
+};
+
+static const struct name kinds[] = {
+	{ "launch", REC_LAUNCH },
+	{ "key_down", REC_KEY_DOWN },
+	{ "key_up", REC_KEY_UP },
+	{ "touch_start", REC_TOUCH_START },
+	{ "touch_move", REC_TOUCH_MOVE },
+	{ "touch_stop", REC_TOUCH_STOP },
+	{ "notify", REC_NOTIFY },
+	{ "click", REC_CLICK },
+	{ "lock", REC_LOCK },
+	{ "type", REC_TYPE },
+	{ "held", REC_HELD },
+	{ NULL, 0 },
+};
+
+static const struct name keys[] = {
+	{ "up", REC_KEY_UP_KEY },
+	{ "down", REC_KEY_DOWN_KEY },
+	{ NULL, 0 },
+};
+
+static const struct name long_presses[] = {
+	{ "none", REC_LONG_PRESS_NONE },
+	{ "up", REC_LONG_PRESS_UP },
+	{ "down", REC_LONG_PRESS_DOWN },
+	{ NULL, 0 },
+};
+
+static const struct name clicks[] = {
+	{ "block", REC_CLICK_BLOCK },
+	{ "settings", REC_CLICK_SETTINGS },
+	{ NULL, 0 },
+};
+
+/* IDLELOCK_* */
+static const struct name locks[] = {
+	{ "off", 0 },
+	{ "on", 1 },
+	{ NULL, 0 },
+};
+
+static const struct name helds[] = {
+	{ "no", 0 },
+	{ "yes", 1 },
+	{ NULL, 0 },
+};
+
+static int lookup(const struct name *t, const char *s)
+{
+	for (; t->name; t++) {
+		if (!strcmp(t->name, s))
+			return t->value;
+	}
+	return -1;
+}
+
+static int parse_arg(int kind, const char *s)
+{
+	switch (kind) {
+	case REC_LAUNCH:
+		return lookup(long_presses, s);
+	case REC_KEY_DOWN:
+	case REC_KEY_UP:
+		return lookup(keys, s);
+	case REC_CLICK:
+		return lookup(clicks, s);
+	case REC_LOCK:
+		return lookup(locks, s);
+	case REC_HELD:
+		return lookup(helds, s);
+	case REC_TOUCH_START:
+	case REC_TOUCH_MOVE:
+	case REC_TOUCH_STOP:
+		return (int)(atof(s) * 1000.0);
+	default:
+		return atoi(s);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *in, *out;
+	char line[LINE_MAX_LEN], kind[32], arg[32];
+	unsigned int ms, lineno = 0;
+	int k, v;
+	struct record_header h = { RECORD_MAGIC, RECORD_VERSION };
+	struct record r;
+	char *p;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s <output> <script>\n", argv[0]);
+		return 1;
+	}
+	in = fopen(argv[2], "r");
+	if (in == NULL) {
+		perror(argv[2]);
+		return 1;
+	}
+	out = fopen(argv[1], "w");
+	if (out == NULL) {
+		perror(argv[1]);
+		fclose(in);
+		return 1;
+	}
+	fwrite(&h, sizeof(h), 1, out);
+
+	while (fgets(line, sizeof(line), in)) {
+		lineno++;
+		p = strchr(line, '#');
+		if (p)
+			*p = '\0';
+		if (sscanf(line, "%u %31s %31s", &ms, kind, arg) != 3)
+			continue;
+
+		k = lookup(kinds, kind);
+		v = k < 0 ? -1 : parse_arg(k, arg);
+		if (v < 0) {
+			fprintf(stderr, "%s:%u: bad input \"%s %s\"\n",
+					argv[2], lineno, kind, arg);
+			fclose(in);
+			fclose(out);
+			remove(argv[1]);
+			return 1;
+		}
+		memset(&r, 0, sizeof(r));
+		r.ms = ms;
+		r.kind = k;
+		r.arg = v;
+		fwrite(&r, sizeof(r), 1, out);
+	}
+
+	fclose(in);
+	if (fclose(out) != 0) {
+		perror(argv[1]);
+		return 1;
+	}
+	return 0;
+}
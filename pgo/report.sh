@@ -0,0 +1,47 @@
+#!/bin/sh
+#
+# Compare a RelWithPGO build against a plain Release build.
+#
+# usage: report.sh <release build dir> <pgo build dir>
+#
+# Both directories hold the "volume" binary and, once "make training"
+# ran on the target, training-trace.tsv with the per phase launch times.
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 <release build dir> <pgo build dir>" >&2
+	exit 1
+fi
+base=$1
+pgo=$2
+
+echo "== size"
+size "$base/volume" "$pgo/volume"
+
+echo "== libraries loaded at exec"
+for d in "$base" "$pgo"; do
+	printf "%s\t%s\n" "$(readelf -dW "$d/volume" | grep -c NEEDED)" "$d/volume"
+done
+
+echo "== dynamic relocations"
+for d in "$base" "$pgo"; do
+	printf "%s\t%s\n" "$(readelf -rW "$d/volume" | grep -c '^[0-9a-f]')" "$d/volume"
+done
+
+if [ ! -f "$base/training-trace.tsv" ] || [ ! -f "$pgo/training-trace.tsv" ]; then
+	echo "== no training-trace.tsv to compare, run \"make training\" in both"
+	exit 0
+fi
+
+echo "== mean msec per launch kind and phase (release, pgo, delta)"
+awk -F'\t' '
+	FNR == 1 { file++ }
+	{ key = $2 "\t" $3; sum[file, key] += $4; cnt[file, key]++; keys[key] = 1 }
+	END {
+		for (k in keys) {
+			if (!cnt[1, k] || !cnt[2, k])
+				continue
+			a = sum[1, k] / cnt[1, k]
+			b = sum[2, k] / cnt[2, k]
+			printf "%s\t%.3f\t%.3f\t%+.1f%%\n", k, a, b, a ? (b - a) * 100 / a : 0
+		}
+	}' "$base/training-trace.tsv" "$pgo/training-trace.tsv" | sort
@@ -0,0 +1,45 @@
+#!/bin/sh
+#
+# Check the launch trace of a replayed workload.
+#
+# usage: trace-check.sh <trace tsv> [<app> <record>]
+#
+# With an app and a record, first replays the record through the app on
+# the simulated backend, writing the trace. ELM_ENGINE and
+# VOLUME_TRACE_BUDGET are taken from the environment.
+# The app appends one line per phase and launch:
+#	<epoch> <launch> <phase> <msec> <budget> <ok|over>
+# Exits 1 when a phase ran over its budget, or when the trace does not
+# hold both a cold and a warm launch.
+
+if [ $# -eq 3 ]; then
+	rm -f "$1"
+	env VOLUME_BACKEND=sim VOLUME_REPLAY="$3" VOLUME_REPLAY_EXIT=1 \
+		VOLUME_TRACE="$1" "$2" || exit 1
+	if [ ! -f "$1" ]; then
+		echo "$2 wrote no trace" >&2
+		exit 1
+	fi
+elif [ $# -ne 1 ] || [ ! -f "$1" ]; then
+	echo "usage: $0 <trace tsv> [<app> <record>]" >&2
+	exit 1
+fi
+
+echo "launch	phase	msec	budget	result"
+awk -F'\t' '
+	{
+		printf "%s\t%s\t%s\t%s\t%s\n", $2, $3, $4, $5, $6
+		if ($6 == "over")
+			over++
+		if ($2 == "cold" || $2 == "snapshot")
+			cold++
+		if ($2 == "warm")
+			warm++
+	}
+	END {
+		if (!cold || !warm) {
+			print "missing a cold or a warm launch" > "/dev/stderr"
+			exit 1
+		}
+		exit over ? 1 : 0
+	}' "$1"
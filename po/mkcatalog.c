@@ -0,0 +1,206 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * mkcatalog: compile the message ids of this package from the given
+ * .po files into one table, see src/_catalog.h for the layout.
+ *
+ * usage: mkcatalog <output> <lang.po>...
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "_catalog.h"
+
+#define LINE_MAX_LEN 4096
+
+static const char *msgids[] = {
+#define CATALOG_MSG(id, msgid) msgid,
+	CATALOG_MSGIDS
+#undef CATALOG_MSG
+};
+
+struct blob {
+	char *buf;
+	size_t len;
+	size_t size;
+};
+
+static uint32_t blob_add(struct blob *b, const char *s)
+{
+	size_t n = strlen(s) + 1;
+	uint32_t off = b->len;
+
+	if (b->len + n > b->size) {
+		b->size = (b->len + n) * 2;
+		b->buf = realloc(b->buf, b->size);
+		if (b->buf == NULL) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+	}
+	memcpy(b->buf + b->len, s, n);
+	b->len += n;
+	return off;
+}
+
+/* append the quoted string of a po line to out, unescaping it */
+static void append_quoted(const char *line, char *out, size_t size)
+{
+	const char *p = strchr(line, '"');
+	size_t len = strlen(out);
+
+	if (p == NULL)
+		return;
+	for (p++; *p && *p != '"' && len + 1 < size; p++) {
+		if (*p == '\\' && p[1]) {
+			p++;
+			switch (*p) {
+			case 'n': out[len++] = '\n'; break;
+			case 't': out[len++] = '\t'; break;
+			default: out[len++] = *p; break;
+			}
+		} else {
+			out[len++] = *p;
+		}
+	}
+	out[len] = '\0';
+}
+
+static int msg_index(const char *msgid)
+{
+	int i;
+
+	for (i = 0; i < CATALOG_MAX; i++) {
+		if (!strcmp(msgids[i], msgid))
+			return i;
+	}
+	return -1;
+}
+
+static int load_po(const char *path, uint32_t *offsets, struct blob *b)
+{
+	FILE *fp;
+	char line[LINE_MAX_LEN];
+	char msgid[LINE_MAX_LEN] = "";
+	char msgstr[LINE_MAX_LEN] = "";
+	char *cur = NULL;
+	int idx;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return -1;
+	}
+
+	for (;;) {
+		char *r = fgets(line, sizeof(line), fp);
+
+		if (r == NULL || !strncmp(line, "msgid ", 6)) {
+			/* flush the previous entry */
+			idx = msg_index(msgid);
+			if (idx >= 0 && msgstr[0])
+				offsets[idx] = blob_add(b, msgstr);
+			msgid[0] = msgstr[0] = '\0';
+			if (r == NULL)
+				break;
+			cur = msgid;
+			append_quoted(line + 5, msgid, sizeof(msgid));
+		} else if (!strncmp(line, "msgstr ", 7)) {
+			cur = msgstr;
+			append_quoted(line + 6, msgstr, sizeof(msgstr));
+		} else if (line[0] == '"' && cur) {
+			append_quoted(line, cur, cur == msgid ?
+					sizeof(msgid) : sizeof(msgstr));
+		} else {
+			cur = NULL;
+		}
+	}
+	fclose(fp);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *fp;
+	int i, n;
+	struct catalog_header hdr;
+	struct catalog_locale *loc;
+	uint32_t *offsets, base;
+	struct blob b = { NULL, 0, 0 };
+
+	if (argc < 3) {
+		fprintf(stderr, "usage: %s <output> <lang.po>...\n", argv[0]);
+		return 1;
+	}
+
+	n = argc - 2;
+	loc = calloc(n, sizeof(*loc));
+	offsets = calloc((size_t)n * CATALOG_MAX, sizeof(*offsets));
+	if (loc == NULL || offsets == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	/* offset 0 means missing, so the blob starts with a dummy byte */
+	blob_add(&b, "");
+	for (i = 0; i < n; i++) {
+		const char *path = argv[i + 2];
+		const char *name = strrchr(path, '/');
+		size_t len;
+
+		name = name ? name + 1 : path;
+		len = strcspn(name, ".");
+		if (len >= CATALOG_LOCALE_LEN) {
+			fprintf(stderr, "locale name too long: %s\n", name);
+			return 1;
+		}
+		memcpy(loc[i].name, name, len);
+		if (load_po(path, offsets + i * CATALOG_MAX, &b) < 0)
+			return 1;
+	}
+
+	/* make the offsets absolute */
+	base = sizeof(hdr) + n * (sizeof(*loc) + CATALOG_MAX * sizeof(*offsets));
+	for (i = 0; i < n * CATALOG_MAX; i++) {
+		if (offsets[i])
+			offsets[i] += base;
+	}
+
+	hdr.magic = CATALOG_MAGIC;
+	hdr.version = CATALOG_VERSION;
+	hdr.n_locales = n;
+	hdr.n_msgs = CATALOG_MAX;
+
+	fp = fopen(argv[1], "wb");
+	if (fp == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+	if (fwrite(&hdr, sizeof(hdr), 1, fp) != 1
+			|| fwrite(loc, sizeof(*loc), n, fp) != (size_t)n
+			|| fwrite(offsets, sizeof(*offsets), n * CATALOG_MAX, fp) != (size_t)n * CATALOG_MAX
+			|| fwrite(b.buf, 1, b.len, fp) != b.len) {
+		perror(argv[1]);
+		fclose(fp);
+		return 1;
+	}
+	fclose(fp);
+	return 0;
+}
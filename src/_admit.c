@@ -0,0 +1,205 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <time.h>
+
+#include "volume.h"
+#include "_util_log.h"
+#include "_logic.h"
+#include "_startup.h"
+#include "_admit.h"
+#include "_stats.h"
+
+/*
+ * Launch admission. Stages run in order, cheapest first, and the first
+ * one rejecting ends the launch before any callback registration or
+ * widget work. The lock and a notified type come from caches, so a
+ * launch rejected by them does no IPC and does not wait on the startup
+ * probe.
+ */
+
+enum {
+	ADMIT_PASS = 0,
+	ADMIT_REJECT,
+};
+
+struct admit_stage {
+	const char *name;
+	int (*check)(struct appdata *ad, struct admit *a);
+	int hist;	/* STATS_ADMIT_*_MS */
+	int counter;	/* STATS_ADMIT_*_REJECT */
+	unsigned int pass;
+	unsigned int reject;
+	double cost;	/* msec, accumulated */
+};
+
+static int cached_lock = -1;
+static int cached_type = -1;
+static int type_tracked = 0;	/* cached_type follows stream notifications */
+static unsigned int cnt_accept, cnt_reject;
+
+static double _now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+void _admit_set_lock(int lock)
+{
+	cached_lock = lock;
+}
+
+/* Only call once a stream change notification is registered. */
+void _admit_track_type(void)
+{
+	type_tracked = 1;
+}
+
+void _admit_set_type(int type)
+{
+	if (type_tracked)
+		cached_type = type;
+}
+
+/* the rules, on whatever of lock and type is known so far */
+static int _verdict(struct admit *a)
+{
+	if (a->type == MM_ERROR_SOUND_VOLUME_CAPTURE_ONLY
+			|| a->type == MM_ERROR_SOUND_INTERNAL) {
+		_D("Do not show by type\n");
+		return ADMIT_REJECT;
+	}
+	if (a->lock == IDLELOCK_ON && a->type >= 0
+			&& a->type != VOLUME_TYPE_MEDIA) {
+		_D("lock is set, not in media\n");
+		return ADMIT_REJECT;
+	}
+	return ADMIT_PASS;
+}
+
+/* idle lock state, kept up to date by a vconf notification */
+static int _stage_lock(struct appdata *ad, struct admit *a)
+{
+	a->type = -1;
+	a->probed = 0;
+	if (a->lock_in != ADMIT_LIVE) {
+		a->lock = a->lock_in;
+		return ADMIT_PASS;
+	}
+	if (cached_lock < 0)
+		cached_lock = _get_vconf_idlelock();
+	a->lock = cached_lock;
+	return ADMIT_PASS;
+}
+
+/* playing type from stream notifications, decides without IPC */
+static int _stage_cached(struct appdata *ad, struct admit *a)
+{
+	if (a->type_in != ADMIT_LIVE)
+		a->type = a->type_in;
+	else if (type_tracked && cached_type >= 0)
+		a->type = cached_type;
+	return _verdict(a);
+}
+
+/* type still unknown: the startup probe has it on the first launch */
+static int _stage_probe(struct appdata *ad, struct admit *a)
+{
+	if (a->type != -1 || a->type_in != ADMIT_LIVE)
+		return ADMIT_PASS;
+
+	_startup_probe_join(ad);
+	_admit_probed(a);
+	if (!a->probed) {
+		a->type = _get_volume_type();
+		_admit_set_type(a->type);
+	}
+	return ADMIT_PASS;
+}
+
+static int _stage_policy(struct appdata *ad, struct admit *a)
+{
+	return _verdict(a);
+}
+
+static struct admit_stage stages[] = {
+	{ "lock", _stage_lock, STATS_ADMIT_LOCK_MS, STATS_ADMIT_LOCK_REJECT, },
+	{ "cached", _stage_cached, STATS_ADMIT_CACHED_MS, STATS_ADMIT_CACHED_REJECT, },
+	{ "probe", _stage_probe, STATS_ADMIT_PROBE_MS, STATS_ADMIT_PROBE_REJECT, },
+	{ "policy", _stage_policy, STATS_ADMIT_POLICY_MS, STATS_ADMIT_POLICY_REJECT, },
+};
+
+int _admit(struct appdata *ad, struct admit *a)
+{
+	int i, ret;
+	double t, cost;
+
+	retvm_if(a == NULL, -1, "Invalid argument: admit is NULL\n");
+
+	for (i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+		t = _now();
+		ret = stages[i].check(ad, a);
+		cost = _now() - t;
+		stages[i].cost += cost;
+		_stats_hist(stages[i].hist, cost);
+		if (ret == ADMIT_REJECT) {
+			stages[i].reject++;
+			cnt_reject++;
+			_stats_inc(stages[i].counter);
+			_D("rejected by %s lock(%d) type(%d)\n",
+					stages[i].name, a->lock, a->type);
+			return -1;
+		}
+		stages[i].pass++;
+	}
+	cnt_accept++;
+	_D("lock(%d) type(%d)\n", a->lock, a->type);
+	return 0;
+}
+
+/* Level and step of the startup probe, first launch only and only when
+ * the probe saw the admitted type. Call after the probe is joined. */
+void _admit_probed(struct admit *a)
+{
+	int lock, type, val, step;
+
+	if (a->probed)
+		return;
+	if (_startup_probe_take(&lock, &type, &val, &step) < 0)
+		return;
+	if (a->type == -1) {
+		a->type = type;
+		_admit_set_type(type);
+	} else if (a->type != type) {
+		return;
+	}
+	a->val = val;
+	a->step = step;
+	a->probed = 1;
+}
+
+void _admit_dump(void)
+{
+	int i;
+
+	_D("admission accept(%u) reject(%u)\n", cnt_accept, cnt_reject);
+	for (i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+		_D("  %s pass(%u) reject(%u) cost(%.3fms)\n", stages[i].name,
+				stages[i].pass, stages[i].reject, stages[i].cost);
+	}
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_ADMIT_H__
+#define __VOLUME_ADMIT_H__
+
+#include <limits.h>
+
+#include "volume.h"
+
+struct admit {
+	int lock;
+	int type;
+	int val;
+	int step;
+	int probed;	/* val and step come from the startup probe */
+	int lock_in;	/* recorded inputs, used instead of the live */
+	int type_in;	/* state unless ADMIT_LIVE */
+};
+
+#define ADMIT_LIVE	INT_MIN
+
+int _admit(struct appdata *ad, struct admit *a);
+void _admit_probed(struct admit *a);
+void _admit_set_lock(int lock);
+void _admit_track_type(void);
+void _admit_set_type(int type);
+void _admit_dump(void);
+
+#endif
+/* __VOLUME_ADMIT_H__ */
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "_util_log.h"
+#include "_trace.h"
+#include "_alloc.h"
+
+/*
+ * Allocation profile, built with ALLOC_PROFILE only. malloc, calloc,
+ * realloc and free are replaced for the whole process, and every call
+ * from the main thread is booked to the innermost open trace phase, or
+ * to "none" outside of one; other threads share a bucket. The first
+ * run of a phase fills caches and is reported apart, later runs are
+ * steady state and checked against the phase budget, in allocations
+ * per run. VOLUME_ALLOC_BUDGET="view=2,key=0" overrides the budgets and
+ * VOLUME_ALLOC names a file every dump appends to, one line per phase:
+ *
+ *	<epoch> <phase> <runs> <allocs> <bytes> <first> <steady max> <budget> <ok|over>
+ */
+
+#if defined(ALLOC_PROFILE)
+
+#define ALLOC_EXPORT __attribute__((visibility("default")))
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *p, size_t size);
+extern void __libc_free(void *p);
+
+#define ALLOC_NONE TRACE_MAX
+#define ALLOC_THREADS (TRACE_MAX + 1)
+#define ALLOC_MAX (TRACE_MAX + 2)
+
+struct alloc_count {
+	unsigned long allocs;
+	unsigned long frees;
+	unsigned long bytes;
+	unsigned int runs;
+	unsigned long run_start;
+	unsigned long first;	/* allocations of the first run */
+	unsigned long steady;	/* most allocations of any later run */
+	long budget;		/* negative if unchecked */
+};
+
+/* the volume step path, nothing to allocate once it ran once */
+static const int step_phases[] = {
+	TRACE_KEY,
+	TRACE_REPEAT,
+	TRACE_VIEW,
+};
+
+static struct alloc_count counts[ALLOC_MAX];
+static pthread_t main_thread;
+static volatile int enabled;
+static const char *alloc_file;
+
+static const char *_name(int bucket)
+{
+	if (bucket == ALLOC_NONE)
+		return "none";
+	if (bucket == ALLOC_THREADS)
+		return "threads";
+	return _trace_name(bucket);
+}
+
+static int _bucket(void)
+{
+	int phase;
+
+	if (!pthread_equal(pthread_self(), main_thread))
+		return ALLOC_THREADS;
+	phase = _trace_current();
+	return phase < 0 ? ALLOC_NONE : phase;
+}
+
+static void _book_alloc(size_t size)
+{
+	struct alloc_count *c = &counts[_bucket()];
+
+	__sync_fetch_and_add(&c->allocs, 1);
+	__sync_fetch_and_add(&c->bytes, size);
+}
+
+static void _book_free(void)
+{
+	__sync_fetch_and_add(&counts[_bucket()].frees, 1);
+}
+
+ALLOC_EXPORT void *malloc(size_t size)
+{
+	if (enabled)
+		_book_alloc(size);
+	return __libc_malloc(size);
+}
+
+ALLOC_EXPORT void *calloc(size_t n, size_t size)
+{
+	if (enabled)
+		_book_alloc(n * size);
+	return __libc_calloc(n, size);
+}
+
+ALLOC_EXPORT void *realloc(void *p, size_t size)
+{
+	if (enabled)
+		_book_alloc(size);
+	return __libc_realloc(p, size);
+}
+
+ALLOC_EXPORT void free(void *p)
+{
+	if (enabled && p)
+		_book_free();
+	__libc_free(p);
+}
+
+static void _set_budget(const char *name, size_t len, long budget)
+{
+	int i;
+
+	for (i = 0; i < TRACE_MAX; i++) {
+		if (strlen(_name(i)) == len && !strncmp(_name(i), name, len)) {
+			counts[i].budget = budget;
+			return;
+		}
+	}
+	_E("Unknown trace phase(%.*s)\n", (int)len, name);
+}
+
+void _alloc_init(void)
+{
+	const char *s, *eq;
+	char *end;
+	long budget;
+	int i;
+
+	for (i = 0; i < ALLOC_MAX; i++)
+		counts[i].budget = -1;
+	for (i = 0; i < sizeof(step_phases) / sizeof(step_phases[0]); i++)
+		counts[step_phases[i]].budget = 0;
+
+	s = getenv("VOLUME_ALLOC_BUDGET");
+	while (s && *s) {
+		eq = strchr(s, '=');
+		if (eq == NULL)
+			break;
+		budget = strtol(eq + 1, &end, 10);
+		if (end != eq + 1)
+			_set_budget(s, eq - s, budget);
+		s = strchr(end, ',');
+		if (s)
+			s++;
+	}
+	alloc_file = getenv("VOLUME_ALLOC");
+
+	main_thread = pthread_self();
+	enabled = 1;
+}
+
+void _alloc_begin(int phase)
+{
+	if (phase < 0 || phase >= TRACE_MAX)
+		return;
+	counts[phase].run_start = counts[phase].allocs;
+}
+
+void _alloc_end(int phase)
+{
+	struct alloc_count *c;
+	unsigned long n;
+
+	if (phase < 0 || phase >= TRACE_MAX)
+		return;
+	c = &counts[phase];
+	n = c->allocs - c->run_start;
+	if (c->runs++ == 0) {
+		c->first = n;
+		return;
+	}
+	if (n > c->steady)
+		c->steady = n;
+	if (c->budget >= 0 && n > c->budget)
+		_E("%s allocated %lu, budget %ld\n", _name(phase), n, c->budget);
+}
+
+/* returns the number of phases over budget */
+int _alloc_dump(void)
+{
+	struct alloc_count *c;
+	FILE *fp = NULL;
+	time_t now;
+	int i, over, n = 0;
+
+	if (alloc_file) {
+		fp = fopen(alloc_file, "a");
+		if (fp == NULL)
+			_E("Failed to open %s\n", alloc_file);
+	}
+	now = time(NULL);
+
+	for (i = 0; i < ALLOC_MAX; i++) {
+		c = &counts[i];
+		if (c->allocs == 0 && c->runs == 0)
+			continue;
+		over = c->budget >= 0 && c->runs > 1 && c->steady > c->budget;
+		n += over;
+		_D("alloc %s runs(%u) allocs(%lu) frees(%lu) bytes(%lu) first(%lu) steady(%lu)%s\n",
+				_name(i), c->runs, c->allocs, c->frees, c->bytes,
+				c->first, c->steady, over ? " over budget" : "");
+		if (fp)
+			fprintf(fp, "%ld\t%s\t%u\t%lu\t%lu\t%lu\t%lu\t%ld\t%s\n",
+					(long)now, _name(i), c->runs, c->allocs,
+					c->bytes, c->first, c->steady, c->budget,
+					over ? "over" : "ok");
+	}
+	if (fp)
+		fclose(fp);
+	return n;
+}
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef __VOLUME_ALLOC_H__
+#define __VOLUME_ALLOC_H__
+
+#if defined(ALLOC_PROFILE)
+void _alloc_init(void);
+void _alloc_begin(int phase);
+void _alloc_end(int phase);
+int _alloc_dump(void);
+
+#  define ALLOC_INIT()		_alloc_init()
+#  define ALLOC_BEGIN(phase)	_alloc_begin(phase)
+#  define ALLOC_END(phase)	_alloc_end(phase)
+#  define ALLOC_DUMP()		_alloc_dump()
+#else
+#  define ALLOC_INIT()
+#  define ALLOC_BEGIN(phase)
+#  define ALLOC_END(phase)
+#  define ALLOC_DUMP()
+#endif
+
+#endif
+/* __VOLUME_ALLOC_H__ */
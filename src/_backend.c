@@ -0,0 +1,160 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <mm_sound.h>
+
+#include "_util_log.h"
+#include "_backend.h"
+
+static int _mm_get_level(int type, int *val)
+{
+	int ret;
+	ret = mm_sound_volume_get_value(type, (unsigned int*)val);
+	retvm_if(ret < 0, -1, "Failed to get level of type(%d)\n", type);
+	return 0;
+}
+
+static int _mm_set_level(int type, int val)
+{
+	int ret;
+	ret = mm_sound_volume_set_value(type, val);
+	retvm_if(ret < 0, -1, "Failed to set level of type(%d)\n", type);
+	return 0;
+}
+
+static int _mm_get_step(int type, int *step)
+{
+	int ret;
+	ret = mm_sound_volume_get_step(type, step);
+	retvm_if(ret < 0, -1, "Failed to get step of type(%d)\n", type);
+	return 0;
+}
+
+static int _mm_get_route(int *route)
+{
+	system_audio_route_device_t device = 0;
+	mm_sound_route_get_playing_device(&device);
+	*route = device;
+	return 0;
+}
+
+static int _mm_get_type(int *type)
+{
+	int ret;
+	volume_type_t cur = -1;
+
+	ret = mm_sound_volume_get_current_playing_type(&cur);
+	switch (ret) {
+		case MM_ERROR_NONE:
+			break;
+		case MM_ERROR_SOUND_VOLUME_NO_INSTANCE:
+		case MM_ERROR_SOUND_VOLUME_CAPTURE_ONLY:
+			cur = VOLUME_TYPE_SYSTEM;
+			break;
+		default:
+			_E("Failed to get sound type(errno:%x)\n", ret);
+			return -1;
+	}
+	*type = cur;
+	return 0;
+}
+
+static int _mm_add_callback(int type, void (*cb)(void *), void *data)
+{
+	return mm_sound_volume_add_callback(type, cb, data);
+}
+
+const struct volume_backend backend_mm = {
+	.name = "mm",
+	.get_level = _mm_get_level,
+	.set_level = _mm_set_level,
+	.get_step = _mm_get_step,
+	.get_route = _mm_get_route,
+	.get_type = _mm_get_type,
+	.add_callback = _mm_add_callback,
+};
+
+static const struct volume_backend *backends[] = {
+	&backend_mm,
+	&backend_sim,
+};
+
+static const struct volume_backend *be = &backend_mm;
+
+/* NULL selects VOLUME_BACKEND, then mm_sound */
+int _backend_init(const char *name)
+{
+	int i;
+
+	if (name == NULL)
+		name = getenv("VOLUME_BACKEND");
+	if (name == NULL)
+		return 0;
+
+	for (i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+		if (!strcmp(backends[i]->name, name)) {
+			be = backends[i];
+			_D("backend(%s)\n", be->name);
+			return 0;
+		}
+	}
+	_E("Unknown backend(%s), using %s\n", name, be->name);
+	return -1;
+}
+
+const char *_backend_name(void)
+{
+	return be->name;
+}
+
+int _backend_get_level(int type, int *val)
+{
+	retvm_if(val == NULL, -1, "Invalid argument: val is NULL\n");
+	return be->get_level(type, val);
+}
+
+int _backend_set_level(int type, int val)
+{
+	return be->set_level(type, val);
+}
+
+int _backend_get_step(int type, int *step)
+{
+	retvm_if(step == NULL, -1, "Invalid argument: step is NULL\n");
+	return be->get_step(type, step);
+}
+
+int _backend_get_route(void)
+{
+	int route = 0;
+	be->get_route(&route);
+	return route;
+}
+
+int _backend_get_type(int *type)
+{
+	retvm_if(type == NULL, -1, "Invalid argument: type is NULL\n");
+	return be->get_type(type);
+}
+
+int _backend_add_callback(int type, void (*cb)(void *), void *data)
+{
+	return be->add_callback(type, cb, data);
+}
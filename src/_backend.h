@@ -0,0 +1,54 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef __VOLUME_BACKEND_H__
+#define __VOLUME_BACKEND_H__
+
+/*
+ * Sound server behind the volume logic.
+ * "mm" talks to mm_sound, "sim" keeps the levels in memory so the core
+ * runs without a sound server. VOLUME_BACKEND picks one at startup.
+ */
+
+struct volume_backend {
+	const char *name;
+	int (*get_level)(int type, int *val);
+	int (*set_level)(int type, int val);
+	int (*get_step)(int type, int *step);
+	int (*get_route)(int *route);
+	int (*get_type)(int *type);	/* type of the stream playing now */
+	int (*add_callback)(int type, void (*cb)(void *), void *data);
+};
+
+extern const struct volume_backend backend_mm;
+extern const struct volume_backend backend_sim;
+
+int _backend_init(const char *name);
+const char *_backend_name(void);
+int _backend_get_level(int type, int *val);
+int _backend_set_level(int type, int val);
+int _backend_get_step(int type, int *step);
+int _backend_get_route(void);
+int _backend_get_type(int *type);
+int _backend_add_callback(int type, void (*cb)(void *), void *data);
+
+void _backend_sim_set_route(int route);
+void _backend_sim_set_type(int type);
+
+#endif
+/* __VOLUME_BACKEND_H__ */
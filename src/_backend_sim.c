@@ -0,0 +1,113 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <mm_sound.h>
+
+#include "_util_log.h"
+#include "_backend.h"
+
+/*
+ * In memory sound server. Levels start at the mm_sound defaults and
+ * a write notifies the registered callback from the writer's thread,
+ * the same contract the mm_sound callbacks have.
+ */
+
+#define SIM_STEP 16
+
+static int sim_level[VOLUME_TYPE_MAX] = {
+	[0 ... VOLUME_TYPE_MAX - 1] = 9,
+};
+
+static struct {
+	void (*cb)(void *);
+	void *data;
+} sim_cb[VOLUME_TYPE_MAX];
+
+static int sim_route = SYSTEM_AUDIO_ROUTE_PLAYBACK_DEVICE_NONE;
+static int sim_type = VOLUME_TYPE_SYSTEM;
+
+static int _sim_get_level(int type, int *val)
+{
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+	*val = sim_level[type];
+	return 0;
+}
+
+static int _sim_set_level(int type, int val)
+{
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+	retvm_if(val < 0 || val >= SIM_STEP, -1,
+			"Invalid level(%d) of type(%d)\n", val, type);
+
+	sim_level[type] = val;
+	if (sim_cb[type].cb)
+		sim_cb[type].cb(sim_cb[type].data);
+	return 0;
+}
+
+static int _sim_get_step(int type, int *step)
+{
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+	*step = SIM_STEP;
+	return 0;
+}
+
+static int _sim_get_route(int *route)
+{
+	*route = sim_route;
+	return 0;
+}
+
+static int _sim_get_type(int *type)
+{
+	*type = sim_type;
+	return 0;
+}
+
+static int _sim_add_callback(int type, void (*cb)(void *), void *data)
+{
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+	sim_cb[type].cb = cb;
+	sim_cb[type].data = data;
+	return 0;
+}
+
+void _backend_sim_set_route(int route)
+{
+	sim_route = route;
+}
+
+void _backend_sim_set_type(int type)
+{
+	if (type >= 0 && type < VOLUME_TYPE_MAX)
+		sim_type = type;
+}
+
+const struct volume_backend backend_sim = {
+	.name = "sim",
+	.get_level = _sim_get_level,
+	.set_level = _sim_set_level,
+	.get_step = _sim_get_step,
+	.get_route = _sim_get_route,
+	.get_type = _sim_get_type,
+	.add_callback = _sim_add_callback,
+};
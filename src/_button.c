@@ -15,12 +15,12 @@
  */
 
 
-#include <ui-gadget.h>
-
 #include "_util_log.h"
 #include "volume.h"
 #include "_sound.h"
 #include "_logic.h"
+#include "_input.h"
+#include "_lazy.h"
 
 static void button_ug_layout_cb(ui_gadget_h ug,
 		enum ug_mode mode, void *priv)
@@ -28,8 +28,8 @@ static void button_ug_layout_cb(ui_gadget_h ug,
 	Evas_Object *base;
 	Evas_Object *win;
 
-	base = ug_get_layout(ug);
-	win = ug_get_window();
+	base = lazy_ug.ug_get_layout(ug);
+	win = lazy_ug.ug_get_window();
 
 	switch (mode) {
 		case UG_MODE_FULLVIEW:
@@ -50,11 +50,11 @@ static void button_ug_destroy_cb(ui_gadget_h ug, void *priv)
 
 	retm_if(ug == NULL, "Invalid argument: ug is NULL\n");
 
-	ug_destroy(ug);
+	lazy_ug.ug_destroy(ug);
 	ad->ug = NULL;
+	_input_event(ad, INPUT_EV_UG_CLOSE);
 
-	ecore_x_netwm_window_type_set(elm_win_xwindow_get(ad->win), ECORE_X_WINDOW_TYPE_NOTIFICATION);
-	utilx_set_window_opaque_state(ecore_x_display_get(), elm_win_xwindow_get(ad->win), UTILX_OPAQUE_STATE_OFF);
+	_set_window_normal(ad, EINA_FALSE);
 	_close_volume(ad);
 }
 
@@ -69,9 +69,8 @@ ui_gadget_h create_button_ug(void *data)
 	cbs.destroy_cb = button_ug_destroy_cb;
 	cbs.priv = (void *)data;
 
-	ecore_x_netwm_window_type_set(elm_win_xwindow_get(ad->win), ECORE_X_WINDOW_TYPE_NORMAL);
-	utilx_set_window_opaque_state(ecore_x_display_get(), elm_win_xwindow_get(ad->win), UTILX_OPAQUE_STATE_ON);
-	ug = ug_create(NULL, "setting-profile-efl", UG_MODE_FULLVIEW, NULL, &cbs);
+	_set_window_normal(ad, EINA_TRUE);
+	ug = lazy_ug.ug_create(NULL, "setting-profile-efl", UG_MODE_FULLVIEW, NULL, &cbs);
 
 	return ug;
 }
@@ -83,8 +82,13 @@ int _open_ug(void *data)
 
 	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
 	retvm_if(ad->win == NULL, -1, "Invalid argument: window is NULL\n");
+	/* only a settings tap needs ui-gadget, it is opened here */
+	retvm_if(_lazy_ug_load() < 0, -1, "Failed to load ui-gadget\n");
 
+	/* UG_INIT_EFL expands to ug_init(), send it to the loaded symbol */
+#define ug_init lazy_ug.ug_init
 	UG_INIT_EFL(ad->win, UG_OPT_INDICATOR_ENABLE);
+#undef ug_init
 	elm_win_indicator_mode_set(ad->win, ELM_WIN_INDICATOR_SHOW);
 	ug = create_button_ug(ad);
 
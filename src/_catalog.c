@@ -0,0 +1,172 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <libintl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "_util_log.h"
+#include "_catalog.h"
+
+#if !defined(PACKAGE)
+#  define PACKAGE "volume"
+#endif
+
+static const char *msgids[] = {
+#define CATALOG_MSG(id, msgid) msgid,
+	CATALOG_MSGIDS
+#undef CATALOG_MSG
+};
+
+static void *map = NULL;
+static size_t map_size;
+static const struct catalog_header *hdr;
+static const uint32_t *row;	/* offsets of the current locale */
+
+/* every name and string ends inside the map, or the catalog is unused */
+static int _catalog_check(size_t strings)
+{
+	const struct catalog_locale *loc = (const void *)(hdr + 1);
+	const uint32_t *off = (const void *)(loc + hdr->n_locales);
+	uint32_t i, n = hdr->n_locales * hdr->n_msgs;
+
+	for (i = 0; i < hdr->n_locales; i++) {
+		if (memchr(loc[i].name, '\0', CATALOG_LOCALE_LEN) == NULL)
+			return -1;
+	}
+	for (i = 0; i < n; i++) {
+		if (off[i] == 0)
+			continue;
+		if (off[i] < strings || off[i] >= map_size
+				|| memchr((const char *)map + off[i], '\0',
+					map_size - off[i]) == NULL)
+			return -1;
+	}
+	return 0;
+}
+
+int _catalog_init(const char *path)
+{
+	int fd;
+	struct stat st;
+	size_t min;
+
+	if (map)
+		return 0;
+
+	fd = open(path, O_RDONLY);
+	retvm_if(fd < 0, -1, "Failed to open %s\n", path);
+	if (fstat(fd, &st) < 0 || st.st_size < sizeof(struct catalog_header)) {
+		_E("Invalid catalog %s\n", path);
+		close(fd);
+		return -1;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		map = NULL;
+		_E("Failed to map %s\n", path);
+		return -1;
+	}
+	map_size = st.st_size;
+
+	hdr = map;
+	if (hdr->n_locales > map_size / sizeof(struct catalog_locale)) {
+		_E("Catalog %s is truncated\n", path);
+		_catalog_fini();
+		return -1;
+	}
+	min = sizeof(*hdr) + hdr->n_locales * (sizeof(struct catalog_locale)
+			+ hdr->n_msgs * sizeof(uint32_t));
+	if (hdr->magic != CATALOG_MAGIC || hdr->version != CATALOG_VERSION
+			|| hdr->n_msgs != CATALOG_MAX || map_size < min) {
+		_E("Catalog %s does not match this build\n", path);
+		_catalog_fini();
+		return -1;
+	}
+	if (_catalog_check(min) < 0) {
+		_E("Catalog %s is corrupt, using gettext\n", path);
+		_catalog_fini();
+		return -1;
+	}
+	return 0;
+}
+
+void _catalog_fini(void)
+{
+	if (map)
+		munmap(map, map_size);
+	map = NULL;
+	hdr = NULL;
+	row = NULL;
+}
+
+/* exact match of len bytes, or of a "<name>_" prefix when prefix is set */
+static int _find_locale(const char *name, size_t len, int prefix)
+{
+	int i;
+	const struct catalog_locale *loc = (const void *)(hdr + 1);
+
+	for (i = 0; i < hdr->n_locales; i++) {
+		if (strncmp(loc[i].name, name, len))
+			continue;
+		if (loc[i].name[len] == '\0' || (prefix && loc[i].name[len] == '_'))
+			return i;
+	}
+	return -1;
+}
+
+/* lang is like "en_US.UTF-8"; falls back to the language alone */
+int _catalog_set_locale(const char *lang)
+{
+	int idx;
+	size_t len;
+	const uint32_t *offsets;
+
+	row = NULL;
+	if (hdr == NULL || lang == NULL)
+		return -1;
+
+	len = strcspn(lang, ".@");
+	idx = len < CATALOG_LOCALE_LEN ? _find_locale(lang, len, 0) : -1;
+	len = strcspn(lang, "_.@");
+	if (idx < 0 && len < CATALOG_LOCALE_LEN)
+		idx = _find_locale(lang, len, 1);
+	if (idx < 0) {
+		_D("no catalog for %s\n", lang);
+		return -1;
+	}
+
+	offsets = (const void *)((const struct catalog_locale *)(hdr + 1)
+			+ hdr->n_locales);
+	row = offsets + idx * hdr->n_msgs;
+	return 0;
+}
+
+const char *_catalog_text(int id)
+{
+	if (id < 0 || id >= CATALOG_MAX)
+		return "";
+	/* offsets were checked by _catalog_init */
+	if (row && row[id])
+		return (const char *)map + row[id];
+	return dgettext(PACKAGE, msgids[id]);
+}
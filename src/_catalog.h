@@ -0,0 +1,69 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_CATALOG_H__
+#define __VOLUME_CATALOG_H__
+
+#include <stdint.h>
+
+/*
+ * Compact message catalog generated from po/ at build time by mkcatalog.
+ *
+ * Layout:
+ *   struct catalog_header
+ *   struct catalog_locale	locale[n_locales]
+ *   uint32_t			offset[n_locales][n_msgs], 0 when missing
+ *   char			strings[], NUL terminated
+ */
+
+#define CATALOG_MAGIC	0x56434154	/* "VCAT" */
+#define CATALOG_VERSION	1
+#define CATALOG_LOCALE_LEN 16
+
+/* message ids of this package, in table order */
+#define CATALOG_MSGIDS \
+	CATALOG_MSG(WARNING_HEARING, "IDS_COM_BODY_HIGH_VOLUMES_MAY_HARM_YOUR_HEARING_IF_YOU_LISTEN_FOR_A_LONG_TIME") \
+	CATALOG_MSG(MEDIA, "IDS_COM_BODY_MEDIA") \
+	CATALOG_MSG(ANDROID, "IDS_COM_BODY_ANDROID") \
+	CATALOG_MSG(JAVA, "IDS_COM_BODY_JAVA") \
+	CATALOG_MSG(HEADPHONES, "IDS_COM_OPT_HEADPHONES_ABB")
+
+enum {
+#define CATALOG_MSG(id, msgid) CATALOG_##id,
+	CATALOG_MSGIDS
+#undef CATALOG_MSG
+	CATALOG_MAX,
+};
+
+struct catalog_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t n_locales;
+	uint32_t n_msgs;
+};
+
+struct catalog_locale {
+	char name[CATALOG_LOCALE_LEN];
+};
+
+int _catalog_init(const char *path);
+void _catalog_fini(void);
+int _catalog_set_locale(const char *lang);
+const char *_catalog_text(int id);
+
+#endif
+/* __VOLUME_CATALOG_H__ */
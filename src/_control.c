@@ -0,0 +1,318 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+
+#include <Ecore.h>
+
+#include "volume.h"
+#include "_util_log.h"
+#include "_control.h"
+#include "_logic.h"
+#include "_sound.h"
+#include "_input.h"
+#include "_level.h"
+#include "_vmem.h"
+#include "_trace.h"
+#include "_stats.h"
+
+Eina_Bool popup_timer_cb(void *data)
+{
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, ECORE_CALLBACK_CANCEL, "Invalid argument: appdata is NULL\n");
+	_D("%s\n", __func__);
+	ad->ptimer = NULL;
+	_close_volume(data);
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/* one long press repeat, the timer stays armed while the level moves */
+static Eina_Bool _long_step(struct appdata *ad, Ecore_Timer **timer, int dir)
+{
+	int val;
+
+	if (!_popup_visible(ad)) {
+		_D("win is NULL or hide state, so long press pass\n");
+		*timer = NULL;
+		return ECORE_CALLBACK_CANCEL;
+	}
+	DEL_TIMER(ad->stimer)
+
+	if (_level_step(ad->type, dir) <= 0) {
+		/* at either end, stop spinning until the key is released */
+		*timer = NULL;
+		return ECORE_CALLBACK_CANCEL;
+	}
+	_level_get(ad->type, &val);
+	_D("%s, type(%d), step(%d) val[%d]\n", dir > 0 ? "up" : "down",
+			ad->type, ad->step, val);
+	return ECORE_CALLBACK_RENEW;
+}
+
+Eina_Bool _lu_timer_cb(void *data)
+{
+	Eina_Bool ret;
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+
+	_trace_begin(TRACE_REPEAT);
+	ret = _long_step(ad, &ad->lutimer, 1);
+	_trace_end(TRACE_REPEAT);
+	return ret;
+}
+
+Eina_Bool _su_timer_cb(void *data)
+{
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+	ad->sutimer = NULL;
+	if (_input_event(ad, INPUT_EV_LONG)) {
+		/* a LONG_PRESS launch can arrive while a repeat runs */
+		DEL_TIMER(ad->lutimer)
+		ADD_TIMER(ad->lutimer, 0.0, _lu_timer_cb, ad)
+	}
+	return ECORE_CALLBACK_CANCEL;
+}
+
+Eina_Bool _ld_timer_cb(void *data)
+{
+	Eina_Bool ret;
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+
+	_trace_begin(TRACE_REPEAT);
+	ret = _long_step(ad, &ad->ldtimer, -1);
+	_trace_end(TRACE_REPEAT);
+	return ret;
+}
+
+Eina_Bool _sd_timer_cb(void *data)
+{
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+	ad->sdtimer = NULL;
+	if (_input_event(ad, INPUT_EV_LONG)) {
+		_D("add long down timer\n");
+		DEL_TIMER(ad->ldtimer)
+		ADD_TIMER(ad->ldtimer, 0.0, _ld_timer_cb, ad)
+	}
+	return ECORE_CALLBACK_CANCEL;
+}
+
+Eina_Bool _slider_timer_cb(void *data)
+{
+	double val;
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+	if ((ad->sl || ad->fl) && _input_event(ad, INPUT_EV_TICK)) {
+		val = _get_slider_value(ad);
+		val += 0.5;
+		if ((int)val != 0) {	/* 0 value could be dealed with in changed callback */
+			_level_set(ad->type, (int)val);
+		}
+		return ECORE_CALLBACK_RENEW;
+	}
+	ad->stimer = NULL;
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/* a volume key went down while the popup is shown */
+void _control_key_down(struct appdata *ad, int key)
+{
+	int val=0, snd;
+
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	if (!_input_event(ad, INPUT_EV_KEY_DOWN)) {
+		return;
+	}
+
+	snd = _get_sound_status();
+
+	DEL_TIMER(ad->ptimer)
+
+	_stats_key(ad->type);
+	if (key == CONTROL_KEY_UP) {
+		_stats_inc(STATS_KEY_UP);
+		_level_read(ad->type, &val);
+		if (val == ad->step) {
+			_play_sound(ad->type);
+			return;
+		}
+		if(!snd){
+			_D("mute and volume up key pressed\n");
+			_set_sound_status(1);
+			if (val == 0 && _vmem_swap_mute(ad->route, ad->type, &val) == 0) {
+				_D("restore level before mute [%d]\n", val);
+				_level_set(ad->type, val);
+				_play_sound(ad->type);
+				return;
+			}
+		}
+		_level_set(ad->type, val + 1);
+		_play_sound(ad->type);
+		DEL_TIMER(ad->sutimer)
+		ADD_TIMER(ad->sutimer, 0.5, _su_timer_cb, ad)
+
+		_D("set volume %d -> [%d]\n", val, val+1);
+
+	} else if (key == CONTROL_KEY_DOWN) {
+		_stats_inc(STATS_KEY_DOWN);
+		if(!snd){
+			/* Do nothing */
+			return;
+		}
+		_level_read(ad->type, &val);
+		if (val == 0) {
+			_play_vib();
+			return;
+		}
+		_level_set(ad->type, val - 1);
+		_play_sound(ad->type);
+		DEL_TIMER(ad->sdtimer)
+		ADD_TIMER(ad->sdtimer, 0.5, _sd_timer_cb, ad)
+
+		_D("type (%d) set volume %d -> [%d]\n", ad->type, val, val-1);
+
+	}
+}
+
+/* a volume key went up while the popup is shown */
+void _control_key_up(struct appdata *ad, int key)
+{
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	if (!_input_event(ad, INPUT_EV_KEY_UP)) {
+		return;
+	}
+
+	if (key == CONTROL_KEY_UP) {
+		_D("up key released and del timer\n");
+		DEL_TIMER(ad->sutimer)
+		DEL_TIMER(ad->lutimer)
+
+	} else if (key == CONTROL_KEY_DOWN) {
+		_D("down key released and del timer\n");
+		DEL_TIMER(ad->sdtimer)
+		DEL_TIMER(ad->ldtimer)
+	}
+
+	DEL_TIMER(ad->ptimer)
+
+	/* In UG, This Callback should not be called. */
+	if ( ad->ug == NULL )
+		ADD_TIMER(ad->ptimer, 3.0, popup_timer_cb, ad)
+}
+
+void _control_touch_start(struct appdata *ad)
+{
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	if (!_input_event(ad, INPUT_EV_TOUCH_START)) {
+		return;
+	}
+
+	DEL_TIMER(ad->ptimer)
+
+	if(!_get_sound_status()){
+		_set_sound_status(1);
+		_set_icon(ad, -1);
+	}
+
+	DEL_TIMER(ad->stimer)
+	ADD_TIMER(ad->stimer, 0.2, _slider_timer_cb, ad)
+}
+
+/* 1 when the level went to 0 and the knob has to follow */
+int _control_touch_move(struct appdata *ad)
+{
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+
+	if (!_input_event(ad, INPUT_EV_TOUCH_MOVE)) {
+		return 0;
+	}
+	if (_get_slider_value(ad) <= 0.5) {
+		_level_set(ad->type, 0);
+		return 1;
+	}
+	return 0;
+}
+
+void _control_touch_stop(struct appdata *ad)
+{
+	double val;
+
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	/* leaving the touch mode cancels the slider timer */
+	if (!_input_event(ad, INPUT_EV_TOUCH_STOP)) {
+		return;
+	}
+	if (ad->sl || ad->fl) {
+		val = _get_slider_value(ad);
+		val += 0.5;
+		_level_set(ad->type, (int)val);
+	}
+	_play_sound(ad->type);
+	DEL_TIMER(ad->ptimer)
+	ADD_TIMER(ad->ptimer, 3.0, popup_timer_cb, ad)
+}
+
+/* timers of a launch: a held key starts its repeat, else the popup
+ * timer runs; a warm launch may find either armed */
+void _control_launch(struct appdata *ad, int held)
+{
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	DEL_TIMER(ad->ptimer)
+	if (held == CONTROL_KEY_UP) {
+		_D("volume up long press\n");
+		DEL_TIMER(ad->sutimer)
+		ADD_TIMER(ad->sutimer, 0.5, _su_timer_cb, ad)
+	} else if (held == CONTROL_KEY_DOWN) {
+		_D("volume down long press\n");
+		DEL_TIMER(ad->sdtimer)
+		ADD_TIMER(ad->sdtimer, 0.5, _sd_timer_cb, ad)
+	} else {
+		ADD_TIMER(ad->ptimer, 3.0, popup_timer_cb, ad)
+	}
+}
+
+/* 1 when the setting ug may open */
+int _control_ug_open(struct appdata *ad)
+{
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+
+	if (!_input_event(ad, INPUT_EV_UG_OPEN))
+		return 0;
+	DEL_TIMER(ad->ptimer)
+	return 1;
+}
+
+/* the popup hides: no input mode and no timer outlives it */
+void _control_hide(struct appdata *ad)
+{
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	_input_event(ad, INPUT_EV_HIDE);
+	DEL_TIMER(ad->sutimer)
+	DEL_TIMER(ad->lutimer)
+	DEL_TIMER(ad->sdtimer)
+	DEL_TIMER(ad->ldtimer)
+	DEL_TIMER(ad->ptimer)
+	DEL_TIMER(ad->stimer)
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_CONTROL_H__
+#define __VOLUME_CONTROL_H__
+
+#include "volume.h"
+
+/*
+ * Popup timers and what the input handlers do once the view let an
+ * event through. No widget is touched here: the view calls it makes go
+ * through the functions below, which _logic.c and _sound.c provide and
+ * the stress check stubs.
+ *
+ *	_close_volume()		_logic.h
+ *	_popup_visible()	_logic.h
+ *	_get_slider_value()	_sound.h
+ *	_set_icon()		_sound.h
+ *	_play_sound()		_sound.h
+ *	_play_vib()		_sound.h
+ *	_get_sound_status()	_sound.h
+ *	_set_sound_status()	_sound.h
+ */
+
+enum {
+	CONTROL_KEY_OTHER = 0,
+	CONTROL_KEY_UP,
+	CONTROL_KEY_DOWN,
+};
+
+Eina_Bool popup_timer_cb(void *data);
+Eina_Bool _su_timer_cb(void *data);
+Eina_Bool _sd_timer_cb(void *data);
+Eina_Bool _lu_timer_cb(void *data);
+Eina_Bool _ld_timer_cb(void *data);
+Eina_Bool _slider_timer_cb(void *data);
+
+void _control_key_down(struct appdata *ad, int key);
+void _control_key_up(struct appdata *ad, int key);
+void _control_touch_start(struct appdata *ad);
+int _control_touch_move(struct appdata *ad);
+void _control_touch_stop(struct appdata *ad);
+void _control_launch(struct appdata *ad, int held);
+int _control_ug_open(struct appdata *ad);
+void _control_hide(struct appdata *ad);
+
+#endif
+/* __VOLUME_CONTROL_H__ */
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <time.h>
+
+#include "volume.h"
+#include "_util_log.h"
+#include "_input.h"
+#include "_stats.h"
+#include "_wakeup.h"
+
+/*
+ * Input arbitration. Key, long press, slider and ug handlers report
+ * their event here first; the table below decides the next mode and
+ * whether the handler should do any work at all. Timers belonging to
+ * the mode being left are cancelled on the transition, so a superseded
+ * repeat never writes a level behind the new owner's back.
+ */
+
+#define DROP	0
+#define WORK	1
+
+struct input_rule {
+	unsigned char next;
+	unsigned char work;
+};
+
+#define R(m, w) { INPUT_##m, w }
+
+static const struct input_rule rules[INPUT_MODE_MAX][INPUT_EV_MAX] = {
+	/* KEY_DOWN, KEY_UP, LONG, TOUCH_START, TOUCH_MOVE, TOUCH_STOP, TICK, UG_OPEN, UG_CLOSE, HIDE */
+	[INPUT_IDLE] = {
+		R(KEY, WORK), R(IDLE, WORK), R(LONG, WORK),
+		R(TOUCH, WORK), R(IDLE, DROP), R(IDLE, DROP), R(IDLE, DROP),
+		R(UG, WORK), R(IDLE, WORK), R(IDLE, WORK),
+	},
+	[INPUT_KEY] = {
+		R(KEY, WORK), R(IDLE, WORK), R(LONG, WORK),
+		R(KEY, DROP), R(KEY, DROP), R(KEY, DROP), R(KEY, DROP),
+		R(UG, WORK), R(KEY, DROP), R(IDLE, WORK),
+	},
+	/* the repeat timer owns the level, key repeats are redundant */
+	[INPUT_LONG] = {
+		R(LONG, DROP), R(IDLE, WORK), R(LONG, WORK),
+		R(LONG, DROP), R(LONG, DROP), R(LONG, DROP), R(LONG, DROP),
+		R(UG, WORK), R(LONG, DROP), R(IDLE, WORK),
+	},
+	[INPUT_TOUCH] = {
+		R(TOUCH, DROP), R(TOUCH, DROP), R(TOUCH, DROP),
+		R(TOUCH, WORK), R(TOUCH, WORK), R(IDLE, WORK), R(TOUCH, WORK),
+		R(UG, WORK), R(TOUCH, DROP), R(IDLE, WORK),
+	},
+	/* the slider is covered by the ug, keys still change the level */
+	[INPUT_UG] = {
+		R(UG, WORK), R(UG, WORK), R(UG, WORK),
+		R(UG, DROP), R(UG, DROP), R(UG, DROP), R(UG, DROP),
+		R(UG, DROP), R(IDLE, WORK), R(IDLE, WORK),
+	},
+};
+
+#undef R
+
+static const char *mode_name[INPUT_MODE_MAX] = {
+	"idle", "key", "long", "touch", "ug",
+};
+
+static unsigned int cnt_transition[INPUT_MODE_MAX][INPUT_MODE_MAX];
+static unsigned int cnt_drop[INPUT_EV_MAX];
+static double long_since;
+
+static double _now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int _is_key_mode(int mode)
+{
+	return mode == INPUT_KEY || mode == INPUT_LONG;
+}
+
+static void _leave_mode(struct appdata *ad, int old, int next)
+{
+	if (next == INPUT_LONG) {
+		long_since = _now();
+		_stats_inc(STATS_LONG_PRESS);
+		WAKEUP_STATE(WAKEUP_LONG_PRESS);
+	} else if (old == INPUT_LONG) {
+		_stats_hist(STATS_LONG_PRESS_MS, _now() - long_since);
+		WAKEUP_STATE(WAKEUP_VISIBLE);
+	}
+	if (_is_key_mode(old) && !_is_key_mode(next)) {
+		DEL_TIMER(ad->sutimer)
+		DEL_TIMER(ad->sdtimer)
+		DEL_TIMER(ad->lutimer)
+		DEL_TIMER(ad->ldtimer)
+	}
+	if (old == INPUT_TOUCH && next != INPUT_TOUCH)
+		DEL_TIMER(ad->stimer)
+}
+
+int _input_event(struct appdata *ad, int ev)
+{
+	const struct input_rule *r;
+	int old;
+
+	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
+	retvm_if(ev < 0 || ev >= INPUT_EV_MAX, 0, "Invalid event(%d)\n", ev);
+
+	old = ad->input_mode;
+	r = &rules[old][ev];
+	if (r->next != old) {
+		_leave_mode(ad, old, r->next);
+		ad->input_mode = r->next;
+		cnt_transition[old][r->next]++;
+		_D("input %s -> %s by event(%d)\n",
+				mode_name[old], mode_name[r->next], ev);
+	}
+	if (r->work == DROP)
+		cnt_drop[ev]++;
+	return r->work;
+}
+
+void _input_dump(void)
+{
+	int i, j;
+
+	for (i = 0; i < INPUT_MODE_MAX; i++) {
+		for (j = 0; j < INPUT_MODE_MAX; j++) {
+			if (cnt_transition[i][j])
+				_D("  %s -> %s (%u)\n", mode_name[i],
+						mode_name[j], cnt_transition[i][j]);
+		}
+	}
+	for (i = 0; i < INPUT_EV_MAX; i++) {
+		if (cnt_drop[i])
+			_D("  event(%d) dropped(%u)\n", i, cnt_drop[i]);
+	}
+}
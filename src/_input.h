@@ -0,0 +1,50 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_INPUT_H__
+#define __VOLUME_INPUT_H__
+
+#include "volume.h"
+
+enum input_mode {
+	INPUT_IDLE = 0,
+	INPUT_KEY,	/* volume key held */
+	INPUT_LONG,	/* long press repeat timer running */
+	INPUT_TOUCH,	/* slider dragged */
+	INPUT_UG,	/* setting ug on top */
+	INPUT_MODE_MAX,
+};
+
+enum input_event {
+	INPUT_EV_KEY_DOWN = 0,
+	INPUT_EV_KEY_UP,
+	INPUT_EV_LONG,
+	INPUT_EV_TOUCH_START,
+	INPUT_EV_TOUCH_MOVE,
+	INPUT_EV_TOUCH_STOP,
+	INPUT_EV_TICK,	/* slider repeat timer */
+	INPUT_EV_UG_OPEN,
+	INPUT_EV_UG_CLOSE,
+	INPUT_EV_HIDE,
+	INPUT_EV_MAX,
+};
+
+int _input_event(struct appdata *ad, int ev);
+void _input_dump(void);
+
+#endif
+/* __VOLUME_INPUT_H__ */
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <dlfcn.h>
+#include <time.h>
+
+#include "_util_log.h"
+#include "_lazy.h"
+
+#ifndef UG_LIB
+#define UG_LIB "libui-gadget-1.so.0"
+#endif
+#ifndef SVI_LIB
+#define SVI_LIB "libsvi.so.0"
+#endif
+
+enum {
+	LAZY_UNTRIED = 0,
+	LAZY_LOADED,
+	LAZY_FAILED,
+};
+
+struct lazy_lib {
+	const char *path;
+	const char *const *names;
+	void **syms;
+	int count;
+	int state;
+	void *dl;
+	double ms;
+};
+
+#define LAZY_NAME(sym) #sym,
+
+struct lazy_ug lazy_ug;
+struct lazy_svi lazy_svi;
+
+static const char *const ug_names[] = { LAZY_UG_SYMS(LAZY_NAME) };
+static const char *const svi_names[] = { LAZY_SVI_SYMS(LAZY_NAME) };
+
+static struct lazy_lib ug_lib = {
+	UG_LIB, ug_names, (void **)&lazy_ug,
+	sizeof(ug_names) / sizeof(ug_names[0]),
+};
+
+static struct lazy_lib svi_lib = {
+	SVI_LIB, svi_names, (void **)&lazy_svi,
+	sizeof(svi_names) / sizeof(svi_names[0]),
+};
+
+static double _now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* all symbols or none: a half loaded table would crash later */
+static int _load(struct lazy_lib *lib)
+{
+	double t;
+	int i;
+
+	if (lib->state != LAZY_UNTRIED)
+		return lib->state == LAZY_LOADED ? 0 : -1;
+
+	t = _now();
+	lib->state = LAZY_FAILED;
+	lib->dl = dlopen(lib->path, RTLD_LAZY | RTLD_LOCAL);
+	retvm_if(lib->dl == NULL, -1, "Failed to open %s: %s\n",
+			lib->path, dlerror());
+
+	for (i = 0; i < lib->count; i++) {
+		lib->syms[i] = dlsym(lib->dl, lib->names[i]);
+		if (lib->syms[i] == NULL) {
+			_E("Failed to find %s in %s\n", lib->names[i], lib->path);
+			for (i = 0; i < lib->count; i++)
+				lib->syms[i] = NULL;
+			dlclose(lib->dl);
+			lib->dl = NULL;
+			return -1;
+		}
+	}
+	lib->state = LAZY_LOADED;
+	lib->ms = _now() - t;
+	_D("%s loaded(%.3fms)\n", lib->path, lib->ms);
+	return 0;
+}
+
+int _lazy_ug_load(void)
+{
+	return _load(&ug_lib);
+}
+
+int _lazy_svi_load(void)
+{
+	return _load(&svi_lib);
+}
+
+void _lazy_dump(void)
+{
+	static const char *state_name[] = { "untried", "loaded", "failed" };
+
+	_D("%s %s(%.3fms)\n", ug_lib.path, state_name[ug_lib.state], ug_lib.ms);
+	_D("%s %s(%.3fms)\n", svi_lib.path, state_name[svi_lib.state], svi_lib.ms);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef __VOLUME_LAZY_H__
+#define __VOLUME_LAZY_H__
+
+#include <ui-gadget.h>
+#include <svi.h>
+
+/*
+ * Libraries only some launches need, opened on first use instead of
+ * at exec. The tables take their types from the library headers; a
+ * symbol stays NULL until its library loaded.
+ */
+
+#define LAZY_UG_SYMS(X) \
+	X(ug_init) \
+	X(ug_create) \
+	X(ug_get_layout) \
+	X(ug_get_window) \
+	X(ug_destroy) \
+	X(ug_destroy_all)
+
+#define LAZY_SVI_SYMS(X) \
+	X(svi_init) \
+	X(svi_fini) \
+	X(svi_play_vib) \
+	X(svi_play_sound)
+
+#define LAZY_SYM(sym) __typeof__(sym) *sym;
+
+struct lazy_ug {
+	LAZY_UG_SYMS(LAZY_SYM)
+};
+
+struct lazy_svi {
+	LAZY_SVI_SYMS(LAZY_SYM)
+};
+
+extern struct lazy_ug lazy_ug;
+extern struct lazy_svi lazy_svi;
+
+int _lazy_ug_load(void);
+int _lazy_svi_load(void);
+void _lazy_dump(void);
+
+#endif
+/* __VOLUME_LAZY_H__ */
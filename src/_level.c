@@ -0,0 +1,129 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <mm_sound.h>
+
+#include "_util_log.h"
+#include "_backend.h"
+#include "_level.h"
+#include "_stats.h"
+
+/* last level known to be on the backend, -1 if unknown */
+static int level[VOLUME_TYPE_MAX] = {
+	[0 ... VOLUME_TYPE_MAX - 1] = -1,
+};
+
+/* highest level per type, fixed by the backend, 0 if unknown */
+static int level_max[VOLUME_TYPE_MAX];
+
+int _level_get(int type, int *val)
+{
+	retvm_if(val == NULL, -1, "Invalid argument: val is NULL\n");
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+
+	if (level[type] < 0)
+		return _level_read(type, val);
+	*val = level[type];
+	return 0;
+}
+
+/* bypass the cache, the level may have changed behind our back */
+int _level_read(int type, int *val)
+{
+	retvm_if(val == NULL, -1, "Invalid argument: val is NULL\n");
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+
+	*val = 0;
+	if (_backend_get_level(type, val) < 0)
+		return -1;
+	level[type] = *val;
+	return 0;
+}
+
+/* returns 1 when the backend was written */
+int _level_set(int type, int val)
+{
+	int max;
+
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+
+	max = _level_max(type);
+	if (val < 0)
+		val = 0;
+	if (max > 0 && val > max)
+		val = max;
+	if (level[type] == val) {
+		_stats_inc(STATS_LEVEL_COALESCED);
+		return 0;
+	}
+	if (_backend_set_level(type, val) < 0)
+		return -1;
+	level[type] = val;
+	_stats_inc(STATS_LEVEL_WRITE);
+	return 1;
+}
+
+/* one key repeat, 0 once the end of the range is reached */
+int _level_step(int type, int dir)
+{
+	int val;
+
+	if (_level_get(type, &val) < 0)
+		return -1;
+	return _level_set(type, dir > 0 ? val + 1 : val - 1);
+}
+
+/* the level read back from the backend or reported by a notification */
+void _level_sync(int type, int val)
+{
+	if (type < 0 || type >= VOLUME_TYPE_MAX)
+		return;
+	level[type] = val;
+}
+
+/* the highest level learned elsewhere, e.g. by the startup probe */
+void _level_sync_max(int type, int max)
+{
+	if (type < 0 || type >= VOLUME_TYPE_MAX || max <= 0)
+		return;
+	level_max[type] = max;
+}
+
+int _level_max(int type)
+{
+	int step;
+
+	retvm_if(type < 0 || type >= VOLUME_TYPE_MAX, -1,
+			"Invalid type(%d)\n", type);
+
+	if (level_max[type] > 0)
+		return level_max[type];
+	retvm_if(_backend_get_step(type, &step) < 0, -1,
+			"Failed to get step\n");
+	level_max[type] = step - 1;
+	return level_max[type];
+}
+
+int _level_warning(int val, int route)
+{
+	return route == SYSTEM_AUDIO_ROUTE_PLAYBACK_DEVICE_EARPHONE
+		&& val >= LEVEL_WARNING;
+}
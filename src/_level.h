@@ -0,0 +1,41 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef __VOLUME_LEVEL_H__
+#define __VOLUME_LEVEL_H__
+
+/*
+ * Level of every volume type as last seen on the backend.
+ * Writes are clamped to the type's range and skipped when the level
+ * would not change, so key repeat and slider drag cost no server call
+ * once they reach an end.
+ */
+
+#define LEVEL_WARNING 13	/* earphone levels from here show the warning */
+
+int _level_get(int type, int *val);
+int _level_read(int type, int *val);
+int _level_set(int type, int val);
+int _level_step(int type, int dir);
+void _level_sync(int type, int val);
+void _level_sync_max(int type, int max);
+int _level_max(int type);
+int _level_warning(int val, int route);
+
+#endif
+/* __VOLUME_LEVEL_H__ */
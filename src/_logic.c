@@ -16,35 +16,147 @@
 
 
 #include <math.h>
+#include <stdlib.h>
 
 #include <Ecore.h>
 #include <Ecore_X.h>
 #include <utilX.h>
 #include <vconf.h>
+#include <vconf-internal-sound-keys.h>
 #include <ui-gadget.h>
 
 #include "volume.h"
 #include "_util_log.h"
 #include "_util_efl.h"
+#include "_logic.h"
 #include "_sound.h"
 #include "_button.h"
+#include "_vmem.h"
+#include "_startup.h"
+#include "_admit.h"
+#include "_catalog.h"
+#include "_input.h"
+#include "_control.h"
+#include "_backend.h"
+#include "_level.h"
+#include "_lazy.h"
+#include "_alloc.h"
+#include "_snapshot.h"
+#include "_trace.h"
+#include "_record.h"
+#include "_watchdog.h"
+#include "_stats.h"
+#include "_wakeup.h"
 
 #define STRBUF_SIZE 128
+#define CATALOG_FILE LOCALEDIR"/"PACKAGE".cat"
 
-enum {
-	IDLELOCK_OFF = 0x0,
-	IDLELOCK_ON,
-	IDLELOCK_MAX,
-};
+/* Grab mode of the volume keys. Only a shared grab leaves the keys to
+ * the other clients, so only then the grab is kept while hidden. */
+#if !defined(KEY_GRAB_MODE)
+#  define KEY_GRAB_MODE TOP_POSITION_GRAB
+#endif
+#define KEY_GRAB_PERSISTENT (KEY_GRAB_MODE == SHARED_GRAB)
 
 void _ungrab_key(struct appdata *ad);
+static void _start_replay(struct appdata *ad);
+
+static double shown_at;	/* when the popup was last shown, 0 while hidden */
+static int replaying = 0;	/* a replayed launch is running */
 
 static void _sound_cb(keynode_t *node, void *data)
 {
+	WAKEUP_BEGIN("vconf sound");
+	WAKEUP_END();
 }
 
 static void _vibration_cb(keynode_t *node, void *data)
 {
+	WAKEUP_BEGIN("vconf vibration");
+	WAKEUP_END();
+}
+
+/* mm moves the playback device some time after the earjack key changes,
+ * restoring before that would write the levels of the old route */
+#define ROUTE_SETTLE_INTERVAL 0.05
+#define ROUTE_SETTLE_TRIES 20
+
+static int route_earjack;
+static int route_tries;
+
+static int _route_settled(void)
+{
+	int route = _backend_get_route();
+
+	if (route_earjack > 0)
+		return route == SYSTEM_AUDIO_ROUTE_PLAYBACK_DEVICE_EARPHONE;
+	return route != SYSTEM_AUDIO_ROUTE_PLAYBACK_DEVICE_EARPHONE;
+}
+
+static Eina_Bool _route_timer_cb(void *data)
+{
+	struct appdata *ad = (struct appdata *)data;
+
+	if (!_route_settled() && ++route_tries < ROUTE_SETTLE_TRIES)
+		return ECORE_CALLBACK_RENEW;
+	ad->rtimer = NULL;
+	if (route_tries < ROUTE_SETTLE_TRIES)
+		_restore_route_levels(ad);
+	else
+		_E("route did not follow earjack %d\n", route_earjack);
+	return ECORE_CALLBACK_CANCEL;
+}
+
+static void _earjack_cb(keynode_t *node, void *data)
+{
+	struct appdata *ad = (struct appdata *)data;
+
+	WAKEUP_BEGIN("vconf earjack");
+	route_earjack = vconf_keynode_get_int(node);
+	route_tries = 0;
+	if (_route_settled()) {
+		DEL_TIMER(ad->rtimer)
+		_restore_route_levels(ad);
+	} else if (ad->rtimer == NULL) {
+		ADD_TIMER(ad->rtimer, ROUTE_SETTLE_INTERVAL, _route_timer_cb, ad);
+	}
+	WAKEUP_END();
+}
+
+static void _idlelock_cb(keynode_t *node, void *data)
+{
+	int lock = vconf_keynode_get_int(node);
+	WAKEUP_BEGIN("vconf idle lock");
+	_admit_set_lock(lock == VCONFKEY_IDLE_LOCK ? IDLELOCK_ON : IDLELOCK_OFF);
+	WAKEUP_END();
+}
+
+/* follow a media stream started under a visible, idle popup */
+static void _retarget(struct appdata *ad, volume_type_t type)
+{
+	if (type != VOLUME_TYPE_MEDIA || type == ad->type)
+		return;
+	if (!(ad->pu || ad->fl) || ad->ug || ad->input_mode != INPUT_IDLE)
+		return;
+	if (ad->win == NULL || evas_object_visible_get(ad->win) == EINA_FALSE)
+		return;
+	_D("retarget type %d -> %d\n", ad->type, type);
+	ad->type = type;
+	_mm_func(ad);
+}
+
+/* a stream started or stopped, the only place the playing type is queried */
+static void _playing_cb(keynode_t *node, void *data)
+{
+	volume_type_t type;
+	struct appdata *ad = (struct appdata *)data;
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	WAKEUP_BEGIN("vconf sound status");
+	type = _get_volume_type();
+	_admit_set_type(type);
+	_retarget(ad, type);
+	WAKEUP_END();
 }
 
 int _init_vconf(struct appdata *ad)
@@ -54,9 +166,38 @@ int _init_vconf(struct appdata *ad)
 	retvm_if(ret < 0, -1, "Failed to notify sound status\n");
 	ret = vconf_notify_key_changed(VCONFKEY_SETAPPL_VIBRATION_STATUS_BOOL, _vibration_cb, ad);
 	retvm_if(ret < 0, -1, "Failed to notifi vibration status\n");
+	ret = vconf_notify_key_changed(VCONFKEY_SYSMAN_EARJACK, _earjack_cb, ad);
+	retvm_if(ret < 0, -1, "Failed to notify earjack status\n");
+	ret = vconf_notify_key_changed(VCONFKEY_IDLE_LOCK_STATE, _idlelock_cb, ad);
+	retvm_if(ret < 0, -1, "Failed to notify idle lock state\n");
+	/* registered before the startup probe reads the type */
+	ret = vconf_notify_key_changed(VCONFKEY_SOUND_STATUS, _playing_cb, ad);
+	retvm_if(ret < 0, -1, "Failed to notify sound status\n");
+	_admit_track_type();
 	return 0;
 }
 
+static void _launched(const char *kind, int counter, double t);
+
+/* cold launch kept while its snapshot is on screen */
+static struct {
+	bundle *b;
+	struct admit a;
+	double t;
+	int replaying;
+} deferred;
+
+/* a close while the snapshot is up: the build it waits for is dropped */
+static void _cancel_deferred(void)
+{
+	if (deferred.b == NULL)
+		return;
+	bundle_free(deferred.b);
+	deferred.b = NULL;
+	_trace_end(TRACE_SNAPSHOT);
+	_launched("cancel", STATS_LAUNCH_CANCEL, deferred.t);
+}
+
 int _close_volume(void *data)
 {
 	struct appdata *ad = (struct appdata *)data;
@@ -66,14 +207,15 @@ int _close_volume(void *data)
 	_D("start closing volume\n");
 	ad->flag_deleting = EINA_TRUE;
 
-	_ungrab_key(ad);
+	if (!KEY_GRAB_PERSISTENT)
+		_ungrab_key(ad);
 
-	DEL_TIMER(ad->sutimer)
-	DEL_TIMER(ad->lutimer)
-	DEL_TIMER(ad->sdtimer)
-	DEL_TIMER(ad->ldtimer)
-	DEL_TIMER(ad->ptimer)
+	_control_hide(ad);
+	DEL_TIMER(ad->warntimer)
 
+	/* nothing is built, shown or read back for a popup going away */
+	_cancel_deferred();
+	_snapshot_drop();
 	if (ad->pu)
 		evas_object_hide(ad->pu);
 	if (ad->win)
@@ -81,129 +223,78 @@ int _close_volume(void *data)
 	appcore_flush_memory();
 
 	ad->flag_deleting = EINA_FALSE;
+	if (shown_at > 0.0) {
+		_stats_hist(STATS_VISIBLE_MS, (ecore_time_get() - shown_at) * 1000.0);
+		shown_at = 0.0;
+	}
+	_record_flush();
+	WAKEUP_STATE(WAKEUP_HIDDEN);
+	WAKEUP_DUMP();
+	ALLOC_DUMP();
+	_admit_dump();
+	_input_dump();
+	_warning_text_dump();
+	_watchdog_dump();
+	_lazy_dump();
 	_D("end closing volume\n");
 	return 0;
 }
 
-Eina_Bool popup_timer_cb(void *data)
+int _popup_visible(struct appdata *ad)
 {
-	_D("%s\n", __func__);
-	_close_volume(data);
-	return ECORE_CALLBACK_CANCEL;
+	return ad->win && evas_object_visible_get(ad->win) == EINA_TRUE;
 }
 
-Eina_Bool _lu_timer_cb(void *data)
+static int _control_key(const char *keyname)
 {
-	int val;
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
-	if (ad->win == NULL || evas_object_visible_get(ad->win) == EINA_FALSE){
-		_D("win is NULL or hide state, so long press pass\n");
-		return ECORE_CALLBACK_CANCEL;
-	}
-	DEL_TIMER(ad->stimer)
-
-	_get_sound_level(ad->type, &val);
-	_set_sound_level(ad->type, val +1 > ad->step ? ad->step : val + 1);
-	_D("down, type(%d), step(%d) val[%d]\n", ad->type, ad->step, val+1);
-	return ECORE_CALLBACK_RENEW;
-}
-
-Eina_Bool _su_timer_cb(void *data)
-{
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
-	ADD_TIMER(ad->lutimer, 0.0, _lu_timer_cb, ad)
-	return ECORE_CALLBACK_CANCEL;
-}
-
-Eina_Bool _ld_timer_cb(void *data)
-{
-	int val;
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
-	if (ad->win == NULL || evas_object_visible_get(ad->win) == EINA_FALSE){
-		_D("win is NULL or hide state, so long press pass\n");
-		return ECORE_CALLBACK_CANCEL;
-	}
-	DEL_TIMER(ad->stimer)
-
-	_get_sound_level(ad->type, &val);
-	_set_sound_level(ad->type, val -1 <= 0 ? 0 : val - 1);
-	_D("down, type(%d), step(%d) val[%d]\n", ad->type, ad->step, val+1);
-	return ECORE_CALLBACK_RENEW;
+	if (!strcmp(keyname, KEY_VOLUMEUP))
+		return CONTROL_KEY_UP;
+	if (!strcmp(keyname, KEY_VOLUMEDOWN))
+		return CONTROL_KEY_DOWN;
+	return CONTROL_KEY_OTHER;
 }
 
-Eina_Bool _sd_timer_cb(void *data)
+static int _record_key(const char *keyname)
 {
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
-	_D("add long down timer\n");
-	ADD_TIMER(ad->ldtimer, 0.0, _ld_timer_cb, ad)
-	return ECORE_CALLBACK_CANCEL;
+	if (!strcmp(keyname, KEY_VOLUMEUP))
+		return REC_KEY_UP_KEY;
+	if (!strcmp(keyname, KEY_VOLUMEDOWN))
+		return REC_KEY_DOWN_KEY;
+	return REC_KEY_OTHER;
 }
 
-static Eina_Bool _key_press_cb(void *data, int type, void *event)
+static Eina_Bool _key_press(void *data, int type, void *event)
 {
 	_D("%s\n", __func__);
-	int val=0, snd=0;
 	Ecore_Event_Key *ev = event;
 	struct appdata *ad = (struct appdata *)data;
 
 	retvm_if(ev == NULL, ECORE_CALLBACK_CANCEL, "Invalid arguemnt: event is NULL\n");
 	retvm_if(ad == NULL, ECORE_CALLBACK_CANCEL, "Invalid argument: appdata is NULL\n");
 	retvm_if(ad->win == NULL, ECORE_CALLBACK_CANCEL, "Invalid argument: window is NULL\n");
+	_record(REC_KEY_DOWN, _record_key(ev->keyname));
 
-	if (ad->flag_touching == EINA_TRUE) {
-		return ECORE_CALLBACK_CANCEL;
+	if (evas_object_visible_get(ad->win) == EINA_FALSE) {
+		return ECORE_CALLBACK_PASS_ON;
 	}
 
-	vconf_get_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, &snd);
-
-	ad->flag_pressing = EINA_TRUE;
-
-	DEL_TIMER(ad->ptimer)
-
-	if (!strcmp(ev->keyname, KEY_VOLUMEUP)) {
-		_get_sound_level(ad->type, &val);
-		if (val == ad->step) {
-			_set_sound_level(ad->type, ad->step);
-			_play_sound(ad->type, ad->sh);
-			return ECORE_CALLBACK_CANCEL;
-		}
-		if(!snd){
-			_D("mute and volume up key pressed\n");
-			vconf_set_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, EINA_TRUE);
-		}
-		_set_sound_level(ad->type, val + 1);
-		_play_sound(ad->type, ad->sh);
-		DEL_TIMER(ad->sutimer)
-		ADD_TIMER(ad->sutimer, 0.5, _su_timer_cb, ad)
-
-		_D("set volume %d -> [%d]\n", val, val+1);
-
-	} else if (!strcmp(ev->keyname, KEY_VOLUMEDOWN)) {
-		if(!snd){
-			/* Do nothing */
-			return ECORE_CALLBACK_CANCEL;
-		}
-		_get_sound_level(ad->type, &val);
-		if (val == 0) {
-			_play_vib(ad->sh);
-			return ECORE_CALLBACK_CANCEL;
-		}
-		_set_sound_level(ad->type, val - 1);
-		_play_sound(ad->type, ad->sh);
-		DEL_TIMER(ad->sdtimer)
-		ADD_TIMER(ad->sdtimer, 0.5, _sd_timer_cb, ad)
+	_control_key_down(ad, _control_key(ev->keyname));
+	return ECORE_CALLBACK_CANCEL;
+}
 
-		_D("type (%d) set volume %d -> [%d]\n", ad->type, val, val-1);
+static Eina_Bool _key_press_cb(void *data, int type, void *event)
+{
+	Eina_Bool ret;
 
-	}
-	return ECORE_CALLBACK_CANCEL;
+	WAKEUP_BEGIN("key down");
+	_trace_begin(TRACE_KEY);
+	ret = _key_press(data, type, event);
+	_trace_end(TRACE_KEY);
+	WAKEUP_END();
+	return ret;
 }
 
-static Eina_Bool _key_release_cb(void *data, int type, void *event)
+static Eina_Bool _key_release(void *data, int type, void *event)
 {
 	Ecore_Event_Key *ev = event;
 	struct appdata *ad = (struct appdata *)data;
@@ -211,78 +302,87 @@ static Eina_Bool _key_release_cb(void *data, int type, void *event)
 	retvm_if(ev == NULL, ECORE_CALLBACK_CANCEL, "Invalid arguemnt: event is NULL\n");
 	retvm_if(ad == NULL, ECORE_CALLBACK_CANCEL, "Invalid argument:appdata is NULL\n");
 	retvm_if(ad->win == NULL, ECORE_CALLBACK_CANCEL, "Invalid argument: window is NULL\n");
+	_record(REC_KEY_UP, _record_key(ev->keyname));
 
-	if (ad->flag_touching == EINA_TRUE) {
-		return ECORE_CALLBACK_CANCEL;
-	}
-
-	if (!strcmp(ev->keyname, KEY_VOLUMEUP)) {
-		_D("up key released and del timer\n");
-		DEL_TIMER(ad->sutimer)
-		DEL_TIMER(ad->lutimer)
-
-	} else if (!strcmp(ev->keyname, KEY_VOLUMEDOWN)) {
-		_D("down key released and del timer\n");
-		DEL_TIMER(ad->sdtimer)
-		DEL_TIMER(ad->ldtimer)
+	if (evas_object_visible_get(ad->win) == EINA_FALSE) {
+		return ECORE_CALLBACK_PASS_ON;
 	}
 
-	ad->flag_pressing = EINA_FALSE;
-
-	DEL_TIMER(ad->ptimer)
+	_control_key_up(ad, _control_key(ev->keyname));
+	return ECORE_CALLBACK_CANCEL;
+}
 
-	/* In UG, This Callback should not be called. */
-	if ( ad->ug == NULL )
-		ADD_TIMER(ad->ptimer, 3.0, popup_timer_cb, ad)
+static Eina_Bool _key_release_cb(void *data, int type, void *event)
+{
+	Eina_Bool ret;
 
-	return ECORE_CALLBACK_CANCEL;
+	WAKEUP_BEGIN("key up");
+	ret = _key_release(data, type, event);
+	WAKEUP_END();
+	return ret;
 }
 
 int _grab_key(struct appdata *ad)
 {
-	Ecore_X_Window xwin;
-	Ecore_X_Display *disp;
 	int ret;
 
 	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
+	retvm_if(ad->disp == NULL, -1, "Failed to get display\n");
+	retvm_if(ad->xwin == 0, -1, "Failed to get xwindow\n");
 
-	disp = ecore_x_display_get();
-	retvm_if(disp == NULL, -1, "Failed to get display\n");
-
-	retvm_if(ad->win == NULL, -1, "Invalid argument: ad->win is NULL\n");
-	xwin = elm_win_xwindow_get(ad->win);
-	retvm_if(xwin == 0, -1, "Failed to get xwindow\n");
+	if (ad->flag_grabbed == EINA_TRUE)
+		return 0;
 
-	ret = utilx_grab_key(disp, xwin, KEY_VOLUMEDOWN, TOP_POSITION_GRAB);
+	ret = utilx_grab_key(ad->disp, ad->xwin, KEY_VOLUMEDOWN, KEY_GRAB_MODE);
 	retvm_if(ret < 0, -1, "Failed to grab key down\n");
 
-	ret = utilx_grab_key(disp, xwin, KEY_VOLUMEUP, TOP_POSITION_GRAB);
-	retvm_if(ret < 0, -1, "Failed to grab key up\n");
-
-	ecore_event_handler_add(ECORE_EVENT_KEY_DOWN, _key_press_cb, ad);
-	ecore_event_handler_add(ECORE_EVENT_KEY_UP, _key_release_cb, ad);
+	ret = utilx_grab_key(ad->disp, ad->xwin, KEY_VOLUMEUP, KEY_GRAB_MODE);
+	if (ret < 0) {
+		_E("Failed to grab key up\n");
+		utilx_ungrab_key(ad->disp, ad->xwin, KEY_VOLUMEDOWN);
+		ecore_x_flush();
+		return -1;
+	}
+	/* send both requests at once, no reply is needed */
+	ecore_x_flush();
+	ad->flag_grabbed = EINA_TRUE;
+
+	if (ad->key_down == NULL)
+		ad->key_down = ecore_event_handler_add(ECORE_EVENT_KEY_DOWN, _key_press_cb, ad);
+	if (ad->key_up == NULL)
+		ad->key_up = ecore_event_handler_add(ECORE_EVENT_KEY_UP, _key_release_cb, ad);
 	_D("key grabed\n");
 	return 0;
 }
 
 void _ungrab_key(struct appdata *ad)
 {
-	Ecore_X_Window xwin;
-	Ecore_X_Display *disp;
-
 	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
-	retm_if(ad->win == NULL, "Invalid argument: ad->win is NULL\n");
 
-	xwin = elm_win_xwindow_get(ad->win);
-	retm_if(xwin == 0, "Failed to get xwindow\n");
+	if (ad->flag_grabbed == EINA_FALSE)
+		return;
+	retm_if(ad->disp == NULL, "Failed to get display\n");
+	retm_if(ad->xwin == 0, "Failed to get xwindow\n");
+
+	utilx_ungrab_key(ad->disp, ad->xwin, KEY_VOLUMEUP);
+	utilx_ungrab_key(ad->disp, ad->xwin, KEY_VOLUMEDOWN);
+	ecore_x_flush();
+	ad->flag_grabbed = EINA_FALSE;
+}
 
-	disp = ecore_x_display_get();
-	retm_if(disp == NULL, "Failed to get display\n");
+void _set_window_normal(struct appdata *ad, Eina_Bool normal)
+{
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+	retm_if(ad->xwin == 0, "Failed to get xwindow\n");
 
-	if (disp && xwin) {
-		utilx_ungrab_key(disp, xwin, KEY_VOLUMEUP);
-		utilx_ungrab_key(disp, xwin, KEY_VOLUMEDOWN);
+	if (normal) {
+		ecore_x_netwm_window_type_set(ad->xwin, ECORE_X_WINDOW_TYPE_NORMAL);
+		utilx_set_window_opaque_state(ad->disp, ad->xwin, UTILX_OPAQUE_STATE_ON);
+	} else {
+		ecore_x_netwm_window_type_set(ad->xwin, ECORE_X_WINDOW_TYPE_NOTIFICATION);
+		utilx_set_window_opaque_state(ad->disp, ad->xwin, UTILX_OPAQUE_STATE_OFF);
 	}
+	ecore_x_flush();
 }
 
 int _get_vconf_idlelock(void)
@@ -300,49 +400,36 @@ int _get_vconf_idlelock(void)
 
 volume_type_t _get_volume_type(void)
 {
-	int ret;
-	volume_type_t type = -1;
-
-	ret = mm_sound_volume_get_current_playing_type(&type);
-	switch (ret) {
-		case MM_ERROR_NONE:
-			break;
-		case MM_ERROR_SOUND_VOLUME_NO_INSTANCE:
-		case MM_ERROR_SOUND_VOLUME_CAPTURE_ONLY:
-			type = VOLUME_TYPE_SYSTEM;
-			break;
-		default:
-			fprintf(stderr, "Failed to get sound type(errno:%x)\n", ret);
-			return -1;
-	}
+	int type = -1;
+
+	if (_backend_get_type(&type) < 0)
+		return -1;
 	if(type == VOLUME_TYPE_SYSTEM)
 		type = VOLUME_TYPE_RINGTONE;
 	return type;
 }
 
-int _check_status(int *lock, int *type)
-{
-	*lock = _get_vconf_idlelock();
-	*type = _get_volume_type();
-	_D("lock(%d) type(%d)\n", *lock, *type);
-
-	if (*type == MM_ERROR_SOUND_VOLUME_CAPTURE_ONLY
-			|| *type == MM_ERROR_SOUND_INTERNAL) {
-		_D("Do not show by type\n");
-		return -1;
-	}
-
-	if (*lock == IDLELOCK_ON && *type != VOLUME_TYPE_MEDIA) {
-		_D("lock is set, not in media\n");
-		return -1;
-	}
-	return 0;
-}
-
 int _app_create(struct appdata *ad)
 {
+	Evas_Object *win;
+
 	_init_vconf(ad);
-	_init_svi(ad);
+	_stats_init();
+	WAKEUP_INIT();
+	_startup_probe_start(ad);
+	_watchdog_start();
+	_catalog_init(CATALOG_FILE);
+
+	/* runs while the probe thread talks to the sound server */
+	win = _add_window(PACKAGE);
+	retvm_if(win == NULL, -1, "Failed add window\n");
+	ad->win = win;
+	ad->xwin = elm_win_xwindow_get(win);
+	ad->disp = ecore_x_display_get();
+
+	if (getenv("VOLUME_RECORD"))
+		_record_init(getenv("VOLUME_RECORD"));
+	_start_replay(ad);
 
 	return 0;
 }
@@ -362,123 +449,55 @@ syspopup_handler handler = {
 	.def_timeout_fn = mytimeout
 };
 
-void _set_level(int type)
-{
-	int val;
-	_get_sound_level(type, &val);
-	_set_sound_level(type, val);
-	_D("type(%d) val(%d)\n", type, val);
-}
-
 static void _block_clicked_cb(void *data, Evas_Object *obj, void *event_info)
 {
+	_record(REC_CLICK, REC_CLICK_BLOCK);
 	_close_volume(data);
 }
 
-Eina_Bool _slider_timer_cb(void *data)
-{
-	double val;
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, 0, "Invalid argument: appdata is NULL\n");
-	if (ad->sl) {
-		val = elm_slider_value_get(ad->sl);
-		val += 0.5;
-		if ((int)val != 0) {	/* 0 value could be dealed with in changed callback */
-			_set_sound_level(ad->type, (int)val);
-		}
-		return ECORE_CALLBACK_RENEW;
-	}
-	return ECORE_CALLBACK_CANCEL;
-}
-
 static void _slider_start_cb(void *data, Evas_Object *obj, void *event_info)
 {
 	_D("%s\n", __func__);
-	int snd=0;
 	struct appdata *ad = (struct appdata *)data;
 	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+	_record(REC_TOUCH_START, (int)(_get_slider_value(ad) * 1000.0));
 
-	if (ad->flag_pressing == EINA_TRUE) {
-		return;
-	}
-	ad->flag_touching = EINA_FALSE;
-
-	DEL_TIMER(ad->ptimer)
-
-	vconf_get_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, &snd);
-	if(!snd){
-		vconf_set_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, EINA_TRUE);
-		_set_icon(data, -1);
-	}
-
-	if (ad->lutimer || ad->ldtimer) {
-		_D("return when long press is working\n");
-		return;
-	}
-
-	ADD_TIMER(ad->stimer, 0.2, _slider_timer_cb, data)
+	_control_touch_start(ad);
 }
 
 static void _slider_changed_cb(void *data, Evas_Object *obj, void *event_info)
 {
-	double val;
 	struct appdata *ad = (struct appdata *)data;
 	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+	_record(REC_TOUCH_MOVE, (int)(_get_slider_value(ad) * 1000.0));
 
-	if (ad->flag_pressing == EINA_TRUE) {
-		return;
-	}
-	if (ad->lutimer || ad->ldtimer) {
-		_D("return when long press is working\n");
-		return;
-	}
-	val = elm_slider_value_get(ad->sl);
-	if (val <= 0.5) {
-		elm_slider_value_set(ad->sl, 0);
-		_set_sound_level(ad->type, 0);
-
+	if (_control_touch_move(ad)) {
+		if (ad->fl)
+			edje_object_part_drag_value_set(ad->fl, "level.knob", 0.0, 0.0);
+		else
+			elm_slider_value_set(ad->sl, 0);
 	}
 }
 static void _slider_stop_cb(void *data, Evas_Object *obj, void *event_info)
 {
 	_D("func\n");
-	double val;
 	struct appdata *ad = (struct appdata *)data;
 	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+	_record(REC_TOUCH_STOP, (int)(_get_slider_value(ad) * 1000.0));
 
-	if (ad->flag_pressing == EINA_TRUE) {
-		return;
-	}
-	if (ad->lutimer || ad->ldtimer) {
-		_D("return when long press is working\n");
-		return;
-	}
-	DEL_TIMER(ad->stimer)
-	if (ad->sl) {
-		val = elm_slider_value_get(ad->sl);
-		val += 0.5;
-		_set_sound_level(ad->type, (int)val);
-	}
-	_play_sound(ad->type, ad->sh);
-	ad->flag_touching = EINA_FALSE;
-	ADD_TIMER(ad->ptimer, 3.0, popup_timer_cb, ad)
+	_control_touch_stop(ad);
 }
 
-Eina_Bool _lu_warmup_timer_cb(void *data)
+/* a replayed launch takes the recorded key state, not the live one */
+static int _key_held(struct appdata *ad, const char *key)
 {
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, ECORE_CALLBACK_CANCEL, "Invalid argument: appdata is NULL\n");
-	ADD_TIMER(ad->lutimer, 0.0, _lu_timer_cb, ad)
-	return ECORE_CALLBACK_CANCEL;
-}
+	int held;
 
-Eina_Bool _ld_warmup_timer_cb(void *data)
-{
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, ECORE_CALLBACK_CANCEL, "Invalid argument: appdata is NULL\n");
-	_D("add long down timer\n");
-	ADD_TIMER(ad->ldtimer, 0.0, _ld_timer_cb, ad)
-	return ECORE_CALLBACK_CANCEL;
+	if (!replaying || _replay_take(REC_HELD, &held) < 0)
+		held = utilx_get_key_status(ad->disp, key)
+			== UTILX_KEY_STATUS_PRESSED;
+	_record(REC_HELD, held);
+	return held;
 }
 
 int _handle_bundle(bundle *b, struct appdata *ad)
@@ -490,28 +509,17 @@ int _handle_bundle(bundle *b, struct appdata *ad)
 	bval = bundle_get_val(b, "LONG_PRESS");
 	if (bval) {
 		_D("val(%s)\n", bval);
-		Ecore_X_Display* disp = ecore_x_display_get();
-		Utilx_Key_Status upstat, downstat;
-
 		if (!strncmp(bval, "VOLUME_UP", strlen("LONG_PRESS"))) {
-			upstat = utilx_get_key_status(disp, KEY_VOLUMEUP);
-			if (upstat == UTILX_KEY_STATUS_PRESSED ) {
-				_D("volume up long press\n");
-				DEL_TIMER(ad->ptimer)
-					ecore_timer_add(0.5, _lu_warmup_timer_cb, ad);
-			}
+			if (_key_held(ad, KEY_VOLUMEUP))
+				_control_launch(ad, CONTROL_KEY_UP);
 		} else if (!strncmp(bval, "VOLUME_DOWN", strlen("LONG_PRESS"))) {
-			downstat = utilx_get_key_status(disp, KEY_VOLUMEDOWN);
-			if (downstat == UTILX_KEY_STATUS_PRESSED ) {
-				_D("volume down long press\n");
-				DEL_TIMER(ad->ptimer)
-				ecore_timer_add(0.5, _ld_warmup_timer_cb, ad);
-			}
+			if (_key_held(ad, KEY_VOLUMEDOWN))
+				_control_launch(ad, CONTROL_KEY_DOWN);
 		} else {
-			ADD_TIMER(ad->ptimer, 3.0, popup_timer_cb, ad)
+			_control_launch(ad, CONTROL_KEY_OTHER);
 		}
 	} else {
-		ADD_TIMER(ad->ptimer, 3.0, popup_timer_cb, ad)
+		_control_launch(ad, CONTROL_KEY_OTHER);
 	}
 	return 0;
 }
@@ -521,9 +529,12 @@ static void _button_cb(void *data, Evas_Object *obj, void *event_info)
 	_D("%s\n", __func__);
 	struct appdata *ad = (struct appdata *)data;
 	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+	_record(REC_CLICK, REC_CLICK_SETTINGS);
 
-	DEL_TIMER(ad->ptimer)
-	_open_ug(ad);
+	if (!_control_ug_open(ad))
+		return;
+	if (_open_ug(ad) < 0)
+		_input_event(ad, INPUT_EV_UG_CLOSE);
 }
 
 Eina_Bool _unset_layout(void *data)
@@ -532,128 +543,420 @@ Eina_Bool _unset_layout(void *data)
 	retvm_if(ad == NULL, EINA_FALSE,"Invalid argument: appdata is NULL\n");
 
 	DEL_TIMER(ad->warntimer);
-	if(elm_object_content_get(ad->pu)==ad->warn_ly){
-		elm_object_content_unset(ad->pu);
-		elm_object_content_set(ad->pu, ad->sl);
-		evas_object_hide(ad->warn_ly);
+	if (ad->fl) {
+		edje_object_signal_emit(ad->fl, "warning,hide", "volume");
+		return ECORE_CALLBACK_CANCEL;
 	}
+	if (ad->warn_ly)
+		elm_object_signal_emit(ad->warn_ly, "warning,hide", "volume");
 	return ECORE_CALLBACK_CANCEL;
 }
 
 int _lang_changed(void *data){
 	_D("%s\n", __func__);
 	struct appdata *ad = (struct appdata *)data;
-	char buf[STRBUF_SIZE] = {0, };
+	char *lang;
 
 	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
-	retvm_if(ad->win == NULL, -1, "Invalid argument: window is NULL\n");
+
+	lang = vconf_get_str(VCONFKEY_LANGSET);
+	_catalog_set_locale(lang ? lang : getenv("LANG"));
+	_set_warning_text(ad, lang ? lang : getenv("LANG"));
+	free(lang);
+
+	if (ad->fl) {
+		edje_object_part_text_set(ad->fl, "settings.text", S_("IDS_COM_BODY_SETTINGS"));
+		return 0;
+	}
+	retvm_if(ad->pu == NULL, -1, "Invalid argument: popup is NULL\n");
 
 	elm_object_text_set(ad->bt, S_("IDS_COM_BODY_SETTINGS"));
-	snprintf(buf, sizeof(buf), "<font_size=32><b>%s</b></font_size>", 
-			T_("IDS_COM_BODY_HIGH_VOLUMES_MAY_HARM_YOUR_HEARING_IF_YOU_LISTEN_FOR_A_LONG_TIME"));
-	elm_object_text_set(ad->warn_lb, buf);
 	return 0;
 }
 
-int _app_reset(bundle *b, void *data)
+#if defined(FLAT_POPUP)
+static void _flat_drag_start_cb(void *data, Evas_Object *obj,
+		const char *emission, const char *source)
 {
-	int ret, status;
-	int lock, type, val;
-	Evas_Object *win, *pu, *ic, *sl, *bt;
+	_slider_start_cb(data, obj, NULL);
+}
+
+static void _flat_drag_cb(void *data, Evas_Object *obj,
+		const char *emission, const char *source)
+{
+	_slider_changed_cb(data, obj, NULL);
+}
+
+static void _flat_drag_stop_cb(void *data, Evas_Object *obj,
+		const char *emission, const char *source)
+{
+	_slider_stop_cb(data, obj, NULL);
+}
+
+static void _flat_clicked_cb(void *data, Evas_Object *obj,
+		const char *emission, const char *source)
+{
+	if (!strcmp(source, "settings"))
+		_button_cb(data, obj, NULL);
+	else
+		_block_clicked_cb(data, obj, NULL);
+}
+
+/* One edje object draws the whole popup. */
+static int _create_flat_popup(struct appdata *ad, struct admit *a)
+{
+	Evas_Object *fl;
+	char buf[STRBUF_SIZE] = {0, };
+
+	fl = _add_edje(ad->win, EDJ_THEME, GRP_VOLUME_FLAT);
+	retvm_if(fl == NULL, -1, "Failed to add flat popup\n");
+	edje_object_signal_callback_add(fl, "drag,start", "level.knob", _flat_drag_start_cb, ad);
+	edje_object_signal_callback_add(fl, "drag", "level.knob", _flat_drag_cb, ad);
+	edje_object_signal_callback_add(fl, "drag,stop", "level.knob", _flat_drag_stop_cb, ad);
+	edje_object_signal_callback_add(fl, "clicked", "*", _flat_clicked_cb, ad);
+	ad->fl = fl;
+
+	_get_title(a->type, buf, sizeof(buf));
+	edje_object_part_text_set(fl, "title", buf);
+	_set_slider_value(ad, a->val);
+	_set_icon(ad, a->val);
+	_lang_changed(ad);
+	return 0;
+}
+#endif
+
+static int _create_popup(struct appdata *ad, struct admit *a)
+{
+	Evas_Object *pu, *ic, *sl, *bt;
 	Evas_Object *label, *warn_ly;
 	char buf[STRBUF_SIZE] = {0, };
+
+	pu = _add_popup(ad->win, "volumebarstyle");
+	retvm_if(pu == NULL, -1, "Failed to add popup\n");
+	evas_object_smart_callback_add(pu, "block,clicked", _block_clicked_cb, ad);
+	_get_title(a->type, buf, sizeof(buf));
+	elm_object_part_text_set(pu, "title,text", buf);
+	ad->pu = pu;
+
+	/* Make a Slider bar */
+	sl = _add_slider(ad->pu, 0, ad->step, a->val);
+	evas_object_smart_callback_add(sl, "slider,drag,start", _slider_start_cb, ad);
+	evas_object_smart_callback_add(sl, "changed", _slider_changed_cb, ad);
+	evas_object_smart_callback_add(sl, "slider,drag,stop", _slider_stop_cb, ad);
+	ad->sl = sl;
+
+	ic = elm_icon_add(ad->pu);
+	evas_object_size_hint_aspect_set(ic, EVAS_ASPECT_CONTROL_VERTICAL, 1, 1);
+	elm_icon_resizable_set(ic, EINA_FALSE, EINA_FALSE);
+	elm_object_part_content_set(ad->sl, "icon", ic);
+	ad->ic = ic;
+	_set_icon(ad, a->val);
+
+	/* Make a Layout for volume slider with warning text. The slider and
+	 * the label stay in it, the warning only switches its state. */
+	label = _add_label(ad->pu, "popup/default", NULL);
+	ad->warn_lb = label;
+
+	warn_ly = _add_layout(ad->pu, EDJ_THEME, GRP_VOLUME_SLIDER_WITH_WARNING);
+	elm_object_part_content_set(warn_ly, "elm.swallow.warn_label", ad->warn_lb);
+	elm_object_part_content_set(warn_ly, "elm.swallow.slider1", ad->sl);
+	ad->warn_ly = warn_ly;
+	elm_object_content_set(ad->pu, ad->warn_ly);
+	_set_warning_text(ad, NULL);
+
+	/* Make a setting button */
+	bt = _add_button(ad->pu, "popup_button/default", S_("IDS_COM_BODY_SETTINGS"));
+	evas_object_smart_callback_add(bt, "clicked", _button_cb, ad);
+	elm_object_part_content_set(ad->pu, "button1", bt);
+	ad->bt = bt;
+	return 0;
+}
+
+static int _record_long_press(bundle *b)
+{
+	const char *bval = bundle_get_val(b, "LONG_PRESS");
+
+	if (bval == NULL)
+		return REC_LONG_PRESS_NONE;
+	if (!strncmp(bval, "VOLUME_UP", strlen("LONG_PRESS")))
+		return REC_LONG_PRESS_UP;
+	if (!strncmp(bval, "VOLUME_DOWN", strlen("LONG_PRESS")))
+		return REC_LONG_PRESS_DOWN;
+	return REC_LONG_PRESS_OTHER;
+}
+
+/* end of a launch: close its trace and count it */
+static void _launched(const char *kind, int counter, double t)
+{
+	_trace_end(TRACE_RESET);
+	_trace_commit(kind);
+	_stats_inc(counter);
+	if (counter == STATS_LAUNCH_COLD || counter == STATS_LAUNCH_WARM) {
+		shown_at = ecore_time_get();
+		_stats_hist(STATS_SHOW_MS, (shown_at - t) * 1000.0);
+		WAKEUP_STATE(WAKEUP_VISIBLE);
+	}
+}
+
+static int _cold_build(struct appdata *ad, bundle *b, struct admit *a,
+		double t, const char *kind);
+static void _snapshot_ready(void *data);
+
+/* appcore's reset, which replayed launches go through */
+static int (*app_reset)(bundle *b, void *data) = _app_reset;
+void _app_set_reset(int (*reset)(bundle *b, void *data))
+{
+	app_reset = reset ? reset : _app_reset;
+}
+
+int _app_reset(bundle *b, void *data)
+{
+	int ret;
+	double t;
+	struct admit a;
 	struct appdata *ad = (struct appdata *)data;
 	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
+	_record(REC_LAUNCH, _record_long_press(b));
+
+	/* a replayed launch decides on the recorded inputs, every launch
+	 * records one pair so the launches of a replay stay paired */
+	a.lock_in = a.type_in = ADMIT_LIVE;
+	if (replaying) {
+		_replay_take(REC_LOCK, &a.lock_in);
+		_replay_take(REC_TYPE, &a.type_in);
+	}
+
+	/* a snapshot launch is still building: this launch joins it and
+	 * the newest bundle decides the long press */
+	if (deferred.b) {
+		bundle_free(deferred.b);
+		deferred.b = bundle_dup(b);
+		deferred.replaying = replaying;
+		_record(REC_LOCK, deferred.a.lock);
+		_record(REC_TYPE, deferred.a.type);
+		_stats_inc(STATS_LAUNCH_MERGED);
+		return 0;
+	}
 
-	ad->flag_touching = EINA_FALSE;
+	t = ecore_time_get();
+	_trace_begin(TRACE_RESET);
+	_trace_begin(TRACE_ADMIT);
+	ret = _admit(ad, &a);
+	_trace_end(TRACE_ADMIT);
+	if (ret < 0) {
+		_record(REC_LOCK, a.lock);
+		_record(REC_TYPE, a.type);
+		/* nothing was registered or created for this launch */
+		_startup_probe_expire();
+		_launched("reject", STATS_LAUNCH_REJECT, t);
+		return 0;
+	}
+
+	/* admission only waits on the probe when no cache knew the type */
+	_startup_probe_join(ad);
+	_admit_probed(&a);
+	_record(REC_LOCK, a.lock);
+	_record(REC_TYPE, a.type);
 
 	_init_mm_sound(ad);
-	status = _check_status(&lock, &type);
-	mm_sound_volume_get_value(type, (unsigned int*)(&val));
-	ad->type = type;
+	if (!a.probed) {
+		_level_read(a.type, &a.val);
+		a.step = -1;
+	}
+	ad->type = a.type;
 
-	if (status == 0) {
-		if(ad->win){
-			_grab_key(ad);
-			_handle_bundle(b, ad);
-			_unset_layout(data);
+	if(ad->pu || ad->fl){
+		_grab_key(ad);
+		_handle_bundle(b, ad);
+		_unset_layout(data);
+		_trace_begin(TRACE_SHOW);
+		if (ad->pu)
 			evas_object_show(ad->pu);
-			evas_object_show(ad->win);
-			_mm_func(data);
-			if(syspopup_has_popup(b))
-				syspopup_reset(b);
-			return 0;
-		}
-		ad->step = _get_step(type);
+		evas_object_show(ad->win);
+		_trace_end(TRACE_SHOW);
+		_trace_begin(TRACE_POPUP);
+		_mm_func(data);
+		_trace_end(TRACE_POPUP);
+		if(syspopup_has_popup(b))
+			syspopup_reset(b);
+		_snapshot_capture(ad);
+		_launched("warm", STATS_LAUNCH_WARM, t);
+		return 0;
+	}
+	if (ad->win == NULL) {
+		_E("Invalid argument: window is NULL\n");
+		_launched("failed", STATS_LAUNCH_FAIL, t);
+		return -1;
+	}
+	ad->step = a.step >= 0 ? a.step : _level_max(a.type);
+
+	/* it sets up the window, rotation included, so it runs before
+	 * the snapshot key is taken or anything is shown */
+	_trace_begin(TRACE_SYSPOPUP);
+	ret = syspopup_create(b, &handler, ad->win, ad);
+	_trace_end(TRACE_SYSPOPUP);
+	if (ret < 0) {
+		_E("Failed to create syspopup\n");
+		_launched("failed", STATS_LAUNCH_FAIL, t);
+		return -1;
+	}
 
-		_set_level(type);
+	/* show what the popup looked like last time while it is built */
+	_trace_begin(TRACE_SNAPSHOT);
+	if (_snapshot_show(ad, a.type, a.val, _snapshot_ready, ad) == 0) {
+		deferred.b = bundle_dup(b);
+		deferred.a = a;
+		deferred.t = t;
+		deferred.replaying = replaying;
+		return 0;
+	}
+	_trace_end(TRACE_SNAPSHOT);
 
-		win = _add_window(PACKAGE);
-		retvm_if(win == NULL, -1, "Failed add window\n");
-		ad->win = win;
+	return _cold_build(ad, b, &a, t, "cold");
+}
 
-		_grab_key(ad);
+static int _cold_build(struct appdata *ad, bundle *b, struct admit *a,
+		double t, const char *kind)
+{
+	int ret;
+
+	_grab_key(ad);
 
-		pu = _add_popup(win, "volumebarstyle");
-		retvm_if(pu == NULL, -1, "Failed to add popup\n");
-		evas_object_smart_callback_add(pu, "block,clicked", _block_clicked_cb, ad);
-		_get_title(type, buf, sizeof(buf));
-		elm_object_part_text_set(pu, "title,text", buf);
-		ad->pu = pu;
-
-		/* Make a Slider bar */
-		sl = _add_slider(ad->pu, 0, ad->step, val);
-		evas_object_smart_callback_add(sl, "slider,drag,start", _slider_start_cb, ad);
-		evas_object_smart_callback_add(sl, "changed", _slider_changed_cb, ad);
-		evas_object_smart_callback_add(sl, "slider,drag,stop", _slider_stop_cb, ad);
-		ad->sl = sl;
-
-		ic = elm_icon_add(ad->pu);
-		evas_object_size_hint_aspect_set(ic, EVAS_ASPECT_CONTROL_VERTICAL, 1, 1);
-		elm_icon_resizable_set(ic, EINA_FALSE, EINA_FALSE);
-		elm_object_part_content_set(ad->sl, "icon", ic);
-		ad->ic = ic;
-		_set_icon(ad, val);
-
-		elm_object_content_set(ad->pu, ad->sl);
-
-		/* Make a Layout for volume slider with warning text. */
-		snprintf(buf, sizeof(buf), "<font_size=32><b>%s</b></font_size>", 
-			T_("IDS_COM_BODY_HIGH_VOLUMES_MAY_HARM_YOUR_HEARING_IF_YOU_LISTEN_FOR_A_LONG_TIME"));
-		label = _add_label(ad->pu, "popup/default", buf);
-		ad->warn_lb = label;
-		evas_object_hide(ad->warn_lb);
-
-		warn_ly = _add_layout(ad->pu, EDJ_THEME, GRP_VOLUME_SLIDER_WITH_WARNING);
-		elm_object_part_content_set(warn_ly, "elm.swallow.warn_label", ad->warn_lb);
-		ad->warn_ly = warn_ly;
-		evas_object_hide(ad->warn_ly);
-
-		/* Make a setting button */
-		bt = _add_button(ad->pu, "popup_button/default", S_("IDS_COM_BODY_SETTINGS"));
-		evas_object_smart_callback_add(bt, "clicked", _button_cb, ad);
-		elm_object_part_content_set(ad->pu, "button1", bt);
-		ad->bt = bt;
-
-		ret = syspopup_create(b, &handler, ad->win, ad);
-		retvm_if(ret < 0, -1, "Failed to create syspopup\n");
+	_trace_begin(TRACE_POPUP);
+#if defined(FLAT_POPUP)
+	ret = _create_flat_popup(ad, a);
+#else
+	ret = _create_popup(ad, a);
+#endif
+	_trace_end(TRACE_POPUP);
+	_snapshot_drop();
 
+	if (ret < 0) {
+		_E("Failed to create popup\n");
+		evas_object_hide(ad->win);
+	} else {
 		_handle_bundle(b, ad);
 
+		_trace_begin(TRACE_SHOW);
 		evas_object_show(ad->win);
+		_trace_end(TRACE_SHOW);
+		_snapshot_capture(ad);
 	}
 
-	return 0;
+	/* every cold launch ends here, built or not */
+	if (ret < 0)
+		_launched("failed", STATS_LAUNCH_FAIL, t);
+	else
+		_launched(kind, STATS_LAUNCH_COLD, t);
+	return ret < 0 ? -1 : 0;
+}
+
+/* the snapshot reached the screen, build the widgets behind it */
+static void _snapshot_ready(void *data)
+{
+	struct appdata *ad = (struct appdata *)data;
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	_trace_end(TRACE_SNAPSHOT);
+	replaying = deferred.replaying;
+	_cold_build(ad, deferred.b, &deferred.a, deferred.t, "snapshot");
+	replaying = 0;
+	bundle_free(deferred.b);
+	deferred.b = NULL;
+}
+
+static void _replay_launch(void *data, int long_press)
+{
+	bundle *b = bundle_create();
+	retm_if(b == NULL, "Failed to create bundle\n");
+
+	if (long_press == REC_LONG_PRESS_UP)
+		bundle_add(b, "LONG_PRESS", "VOLUME_UP");
+	else if (long_press == REC_LONG_PRESS_DOWN)
+		bundle_add(b, "LONG_PRESS", "VOLUME_DOWN");
+	else if (long_press == REC_LONG_PRESS_OTHER)
+		bundle_add(b, "LONG_PRESS", "OTHER");
+	replaying = 1;
+	app_reset(b, data);
+	replaying = 0;
+	bundle_free(b);
+}
+
+static void _replay_key(void *data, int key, int down)
+{
+	Ecore_Event_Key ev = {0, };
+
+	if (key == REC_KEY_UP_KEY)
+		ev.keyname = KEY_VOLUMEUP;
+	else if (key == REC_KEY_DOWN_KEY)
+		ev.keyname = KEY_VOLUMEDOWN;
+	else
+		return;
+	if (down)
+		_key_press_cb(data, ECORE_EVENT_KEY_DOWN, &ev);
+	else
+		_key_release_cb(data, ECORE_EVENT_KEY_UP, &ev);
+}
+
+static void _replay_touch(void *data, int kind, double val)
+{
+	struct appdata *ad = (struct appdata *)data;
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	/* move the knob as the finger did, then run the slider callback */
+	if (ad->fl)
+		edje_object_part_drag_value_set(ad->fl, "level.knob",
+				ad->step > 0 ? val / ad->step : 0.0, 0.0);
+	else if (ad->sl)
+		elm_slider_value_set(ad->sl, val);
+	else
+		return;
+
+	if (kind == REC_TOUCH_START)
+		_slider_start_cb(data, NULL, NULL);
+	else if (kind == REC_TOUCH_MOVE)
+		_slider_changed_cb(data, NULL, NULL);
+	else
+		_slider_stop_cb(data, NULL, NULL);
+}
+
+static void _replay_notify(void *data, int type)
+{
+	_mm_notify(type);
+}
+
+static void _replay_click(void *data, int target)
+{
+	if (target == REC_CLICK_SETTINGS)
+		_button_cb(data, NULL, NULL);
+	else
+		_block_clicked_cb(data, NULL, NULL);
+}
+
+static const struct record_ops replay_ops = {
+	.launch = _replay_launch,
+	.key = _replay_key,
+	.touch = _replay_touch,
+	.notify = _replay_notify,
+	.click = _replay_click,
+};
+
+/* VOLUME_REPLAY names a recorded file, VOLUME_REPLAY_FAST drops the spacing */
+static void _start_replay(struct appdata *ad)
+{
+	const char *path = getenv("VOLUME_REPLAY");
+	if (path == NULL)
+		return;
+	_replay_start(path, &replay_ops, ad, getenv("VOLUME_REPLAY_FAST") == NULL);
 }
 
 int _app_pause(struct appdata *ad)
 {
 	_D("%s\n", __func__);
 	if(ad->ug){
-		ug_destroy_all();
+		lazy_ug.ug_destroy_all();
 		ad->ug = NULL;
-		ecore_x_netwm_window_type_set(elm_win_xwindow_get(ad->win), ECORE_X_WINDOW_TYPE_NOTIFICATION);
-		utilx_set_window_opaque_state(ecore_x_display_get(), elm_win_xwindow_get(ad->win), UTILX_OPAQUE_STATE_OFF);
+		_set_window_normal(ad, EINA_FALSE);
 	}
 	_close_volume(ad);
 	return 0;
@@ -21,13 +21,23 @@
 #include "volume.h"
 #include <bundle.h>
 
+enum {
+	IDLELOCK_OFF = 0x0,
+	IDLELOCK_ON,
+	IDLELOCK_MAX,
+};
+
 int _close_volume(void *data);
+int _popup_visible(struct appdata *ad);
+int _get_vconf_idlelock(void);
+volume_type_t _get_volume_type(void);
 int _app_create(struct appdata *ad);
 int _app_pause(struct appdata *ad);
 int _app_reset(bundle *b, void *data);
-Eina_Bool popup_timer_cb(void *data);
+void _app_set_reset(int (*reset)(bundle *b, void *data));
 Eina_Bool _unset_layout(void *data);
 int _lang_changed(void *data);
+void _set_window_normal(struct appdata *ad, Eina_Bool normal);
 
 #endif
 /* __VOLUME_LOGIC_H__ */
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "_notify.h"
+
+/*
+ * Called on the thread delivering the notification.
+ * Returns 1 when the consumer has to be woken up, 0 when a wakeup is
+ * already on its way and -1 when the notification was dropped.
+ */
+int _notify_push(struct notify_queue *q, int type)
+{
+	unsigned int bit, head;
+
+	if (type < 0 || type >= 32)
+		return -1;
+
+	bit = 1U << type;
+	if (__sync_fetch_and_or(&q->pending, bit) & bit)
+		return 0;	/* collapsed into the queued one */
+
+	head = q->head;
+	if (head - q->tail >= NOTIFY_RING_SIZE) {
+		__sync_fetch_and_and(&q->pending, ~bit);
+		return -1;
+	}
+	q->ring[head & (NOTIFY_RING_SIZE - 1)] = type;
+	__sync_synchronize();
+	q->head = head + 1;
+
+	return __sync_lock_test_and_set(&q->wake, 1) == 0 ? 1 : 0;
+}
+
+/* Called on the main loop before draining the queue. */
+void _notify_rearm(struct notify_queue *q)
+{
+	__sync_lock_release(&q->wake);
+	__sync_synchronize();
+}
+
+int _notify_pop(struct notify_queue *q, int *type)
+{
+	unsigned int tail = q->tail;
+
+	if (tail == q->head)
+		return -1;
+	__sync_synchronize();
+	*type = q->ring[tail & (NOTIFY_RING_SIZE - 1)];
+	/* a notification arriving from now on is queued again */
+	__sync_fetch_and_and(&q->pending, ~(1U << *type));
+	__sync_synchronize();
+	q->tail = tail + 1;
+	return 0;
+}
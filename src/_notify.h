@@ -0,0 +1,42 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_NOTIFY_H__
+#define __VOLUME_NOTIFY_H__
+
+/*
+ * Single producer / single consumer queue of volume types.
+ * A type already waiting in the queue is not queued again: the consumer
+ * reads the current level anyway, so the last notification wins.
+ */
+
+#define NOTIFY_RING_SIZE 32	/* power of 2, more than the volume types */
+
+struct notify_queue {
+	volatile unsigned int head;	/* written by the producer */
+	volatile unsigned int tail;	/* written by the consumer */
+	volatile unsigned int pending;	/* bit per queued type */
+	volatile int wake;		/* consumer wakeup requested */
+	int ring[NOTIFY_RING_SIZE];
+};
+
+int _notify_push(struct notify_queue *q, int type);
+int _notify_pop(struct notify_queue *q, int *type);
+void _notify_rearm(struct notify_queue *q);
+
+#endif
+/* __VOLUME_NOTIFY_H__ */
@@ -0,0 +1,285 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "volume.h"
+#include "_util_log.h"
+#include "_record.h"
+
+/*
+ * Input recorder. When enabled, launches, volume keys, slider drags,
+ * settings and dim clicks and mm_sound notifications are appended as
+ * fixed size records to a file. Replay reads such a file back and
+ * feeds each record to the same handlers, either with the recorded
+ * spacing or back to back, and logs what every kind of input cost.
+ *
+ * A launch also depends on state it reads from the system: the idle
+ * lock, the playing type and whether a long pressed key is still down.
+ * Those are recorded as input records too. Replay does not dispatch
+ * them; the launch asks for the next one of its kind instead of reading
+ * the live value, so a replayed launch takes the recorded decisions.
+ */
+
+static FILE *rec_fp = NULL;
+static double rec_base;
+static int rec_paused = 0;
+
+struct replay {
+	FILE *fp;
+	const struct record_ops *ops;
+	void *data;
+	int realtime;
+	Ecore_Timer *timer;
+	struct record next;
+	uint32_t last_ms;
+	int in_fd;	/* launch inputs, read ahead of the stream */
+	off_t in_off[REC_KIND_MAX];
+	double start;
+
+	unsigned int cnt[REC_KIND_MAX];
+	double cost[REC_KIND_MAX];	/* msec */
+	double max[REC_KIND_MAX];
+};
+
+static struct replay rp = { .in_fd = -1, };
+
+static const char *kind_name[REC_KIND_MAX] = {
+	"", "launch", "key_down", "key_up", "touch_start", "touch_move",
+	"touch_stop", "notify", "click", "lock", "type", "held",
+};
+
+static double _now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int _record_init(const char *path)
+{
+	struct record_header h = { RECORD_MAGIC, RECORD_VERSION };
+
+	retvm_if(path == NULL, -1, "Invalid argument: path is NULL\n");
+	if (rec_fp)
+		return 0;
+
+	rec_fp = fopen(path, "w");
+	retvm_if(rec_fp == NULL, -1, "Failed to open %s\n", path);
+	setvbuf(rec_fp, NULL, _IOFBF, 4096);
+	fwrite(&h, sizeof(h), 1, rec_fp);
+	rec_base = _now();
+	_D("recording input to %s\n", path);
+	return 0;
+}
+
+/* main loop only */
+void _record(int kind, int arg)
+{
+	struct record r;
+
+	if (rec_fp == NULL || rec_paused)
+		return;
+	r.ms = (uint32_t)(_now() - rec_base);
+	r.kind = kind;
+	r.pad = 0;
+	r.arg = arg;
+	fwrite(&r, sizeof(r), 1, rec_fp);
+}
+
+/* called when the popup closes, so a killed process loses little */
+void _record_flush(void)
+{
+	if (rec_fp)
+		fflush(rec_fp);
+}
+
+void _record_fini(void)
+{
+	if (rec_fp) {
+		fclose(rec_fp);
+		rec_fp = NULL;
+	}
+	if (rp.fp) {
+		DEL_TIMER(rp.timer)
+		fclose(rp.fp);
+		rp.fp = NULL;
+	}
+	if (rp.in_fd >= 0) {
+		close(rp.in_fd);
+		rp.in_fd = -1;
+	}
+}
+
+static void _replay_dump(void)
+{
+	int i;
+
+	_D("replay done(%.1fms)\n", _now() - rp.start);
+	for (i = 1; i < REC_KIND_MAX; i++) {
+		if (rp.cnt[i] == 0)
+			continue;
+		_D("  %s count(%u) total(%.3fms) max(%.3fms)\n", kind_name[i],
+				rp.cnt[i], rp.cost[i], rp.max[i]);
+	}
+}
+
+static void _replay_dispatch(struct record *r)
+{
+	const struct record_ops *ops = rp.ops;
+
+	switch (r->kind) {
+	case REC_LAUNCH:
+		ops->launch(rp.data, r->arg);
+		break;
+	case REC_KEY_DOWN:
+	case REC_KEY_UP:
+		ops->key(rp.data, r->arg, r->kind == REC_KEY_DOWN);
+		break;
+	case REC_TOUCH_START:
+	case REC_TOUCH_MOVE:
+	case REC_TOUCH_STOP:
+		ops->touch(rp.data, r->kind, r->arg / 1000.0);
+		break;
+	case REC_NOTIFY:
+		ops->notify(rp.data, r->arg);
+		break;
+	case REC_CLICK:
+		ops->click(rp.data, r->arg);
+		break;
+	case REC_LOCK:
+	case REC_TYPE:
+	case REC_HELD:
+		/* handed to the launch by _replay_take */
+		break;
+	default:
+		_E("Unknown record kind(%d)\n", r->kind);
+		break;
+	}
+}
+
+static Eina_Bool _replay_cb(void *data);
+
+static int _replay_next(void)
+{
+	double delay = 0.0;
+	uint32_t last = rp.next.ms;
+
+	if (fread(&rp.next, sizeof(rp.next), 1, rp.fp) != 1) {
+		_replay_dump();
+		fclose(rp.fp);
+		rp.fp = NULL;
+		rec_paused = 0;
+		/* scripted runs, e.g. the profile training, end with the replay */
+		if (getenv("VOLUME_REPLAY_EXIT"))
+			ecore_main_loop_quit();
+		return -1;
+	}
+	if (rp.realtime && rp.next.ms > last)
+		delay = (rp.next.ms - last) / 1000.0;
+	ADD_TIMER(rp.timer, delay, _replay_cb, NULL)
+	return 0;
+}
+
+static Eina_Bool _replay_cb(void *data)
+{
+	double t;
+	int kind = rp.next.kind;
+
+	rp.timer = NULL;
+	t = _now();
+	_replay_dispatch(&rp.next);
+	t = _now() - t;
+	if (kind > 0 && kind < REC_KIND_MAX) {
+		rp.cnt[kind]++;
+		rp.cost[kind] += t;
+		if (t > rp.max[kind])
+			rp.max[kind] = t;
+	}
+	_replay_next();
+	return ECORE_CALLBACK_CANCEL;
+}
+
+int _replay_start(const char *path, const struct record_ops *ops,
+		void *data, int realtime)
+{
+	struct record_header h;
+	int i;
+
+	retvm_if(path == NULL || ops == NULL, -1, "Invalid argument\n");
+	retvm_if(rp.fp != NULL, -1, "Replay is running\n");
+
+	rp.fp = fopen(path, "r");
+	retvm_if(rp.fp == NULL, -1, "Failed to open %s\n", path);
+	if (fread(&h, sizeof(h), 1, rp.fp) != 1
+			|| h.magic != RECORD_MAGIC || h.version < 1
+			|| h.version > RECORD_VERSION) {
+		_E("Not a volume record file(%s)\n", path);
+		fclose(rp.fp);
+		rp.fp = NULL;
+		return -1;
+	}
+	/* version 1 files have no launch inputs, those launches read live */
+	if (rp.in_fd >= 0)
+		close(rp.in_fd);
+	rp.in_fd = -1;
+	if (h.version >= 2)
+		rp.in_fd = open(path, O_RDONLY);
+	for (i = 0; i < REC_KIND_MAX; i++)
+		rp.in_off[i] = sizeof(h);
+
+	rp.ops = ops;
+	rp.data = data;
+	rp.realtime = realtime;
+	rp.next.ms = 0;
+	rp.start = _now();
+	/* do not record what is being replayed */
+	rec_paused = 1;
+	_D("replaying %s %s\n", path, realtime ? "in real time" : "back to back");
+	return _replay_next();
+}
+
+/*
+ * Next recorded launch input of a kind, in recording order. Fails when
+ * no replay supplies one, the caller then reads the live value. Stays
+ * usable after the stream ends, a snapshot launch finishes later.
+ */
+int _replay_take(int kind, int *arg)
+{
+	struct record r;
+	off_t off;
+
+	if (rp.in_fd < 0 || kind <= 0 || kind >= REC_KIND_MAX || arg == NULL)
+		return -1;
+
+	off = rp.in_off[kind];
+	while (pread(rp.in_fd, &r, sizeof(r), off) == sizeof(r)) {
+		off += sizeof(r);
+		if (r.kind != kind)
+			continue;
+		rp.in_off[kind] = off;
+		*arg = r.arg;
+		return 0;
+	}
+	rp.in_off[kind] = off;
+	_D("No recorded %s left\n", kind_name[kind]);
+	return -1;
+}
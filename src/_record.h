@@ -0,0 +1,90 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_RECORD_H__
+#define __VOLUME_RECORD_H__
+
+#include <stdint.h>
+
+#define RECORD_MAGIC	0x43455256	/* "VREC" */
+#define RECORD_VERSION	2	/* 2 adds the launch inputs */
+
+struct record_header {
+	uint32_t magic;
+	uint32_t version;
+};
+
+struct record {
+	uint32_t ms;	/* since the recorder was opened */
+	uint16_t kind;
+	uint16_t pad;
+	int32_t arg;
+};
+
+enum record_kind {
+	REC_LAUNCH = 1,	/* arg: REC_LONG_PRESS_* */
+	REC_KEY_DOWN,	/* arg: REC_KEY_* */
+	REC_KEY_UP,
+	REC_TOUCH_START,	/* arg: slider value * 1000 */
+	REC_TOUCH_MOVE,
+	REC_TOUCH_STOP,
+	REC_NOTIFY,	/* arg: volume type */
+	REC_CLICK,	/* arg: REC_CLICK_* */
+	/* what a launch read from the system, handed back by _replay_take */
+	REC_LOCK,	/* arg: idle lock */
+	REC_TYPE,	/* arg: playing volume type or mm_sound error */
+	REC_HELD,	/* arg: long pressed key still down */
+	REC_KIND_MAX,
+};
+
+enum {
+	REC_KEY_UP_KEY = 0,
+	REC_KEY_DOWN_KEY,
+	REC_KEY_OTHER,
+};
+
+enum {
+	REC_LONG_PRESS_NONE = 0,
+	REC_LONG_PRESS_UP,
+	REC_LONG_PRESS_DOWN,
+	REC_LONG_PRESS_OTHER,
+};
+
+enum {
+	REC_CLICK_BLOCK = 0,
+	REC_CLICK_SETTINGS,
+};
+
+/* replay feeds every record back through one of these */
+struct record_ops {
+	void (*launch)(void *data, int long_press);
+	void (*key)(void *data, int key, int down);
+	void (*touch)(void *data, int kind, double val);
+	void (*notify)(void *data, int type);
+	void (*click)(void *data, int target);
+};
+
+int _record_init(const char *path);
+void _record(int kind, int arg);
+void _record_flush(void);
+void _record_fini(void);
+int _replay_start(const char *path, const struct record_ops *ops,
+		void *data, int realtime);
+int _replay_take(int kind, int *arg);
+
+#endif
+/* __VOLUME_RECORD_H__ */
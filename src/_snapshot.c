@@ -0,0 +1,428 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vconf.h>
+
+#include "_util_log.h"
+#include "_snapshot.h"
+#include "_sound.h"
+
+/*
+ * Cold start snapshot. A while after the popup is shown it is read
+ * back from our own window, cropped to its opaque box and written to a
+ * raw file named after what it looks like: language, theme, rotation,
+ * window size, volume type, route, sound and vibration status and the
+ * edje file it was drawn from. A look with a file is not read again.
+ * The level box, the slider and its icon, is blanked in the file. The
+ * next cold start maps that file, shows it as one image with the level
+ * drawn live over it, and builds the real widgets only after the
+ * window is mapped and the image went to the screen.
+ */
+
+#define SNAPSHOT_WAIT 0.1	/* sec, build anyway if no frame came */
+#define SNAPSHOT_SETTLE 1.0	/* sec, shown before it is read back */
+#define SNAPSHOT_PATH_SIZE 256
+
+static struct {
+	void *map;
+	size_t size;
+	Evas_Object *img;
+	Evas_Object *level;
+	Evas *evas;
+	Ecore_X_Window xwin;
+	Ecore_Event_Handler *shown;
+	Ecore_Timer *timer;
+	Ecore_Job *job;
+	Ecore_Timer *settle;	/* capture of a look without a file */
+	int mapped;
+	void (*ready)(void *data);
+	void *data;
+} snap;
+
+static uint32_t _key(struct appdata *ad, int type)
+{
+	char buf[SNAPSHOT_PATH_SIZE];
+	const char *lang = getenv("LANG");
+	const char *theme = elm_theme_get(NULL);
+	struct stat st;
+	uint32_t h = 5381;
+	int w = 0, ht = 0, snd = 0, vib = 0, i;
+
+	evas_object_geometry_get(ad->win, NULL, NULL, &w, &ht);
+	vconf_get_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, &snd);
+	vconf_get_bool(VCONFKEY_SETAPPL_VIBRATION_STATUS_BOOL, &vib);
+	if (stat(EDJ_THEME, &st) < 0)
+		st.st_mtime = 0;
+#if defined(FLAT_POPUP)
+	i = 1;
+#else
+	i = 0;
+#endif
+	snprintf(buf, sizeof(buf), "%s|%s|%d|%dx%d|%d|%d|%d%d|%ld|%d",
+			lang ? lang : "", theme ? theme : "",
+			elm_win_rotation_get(ad->win), w, ht, type, ad->route,
+			snd, vib, (long)st.st_mtime, i);
+
+	for (i = 0; buf[i]; i++)
+		h = h * 33 + (unsigned char)buf[i];
+	return h;
+}
+
+static void _path(uint32_t key, char *path, int size)
+{
+	snprintf(path, size, DATADIR"/.volume_snap_%08x", key);
+}
+
+static void _unmap(void)
+{
+	if (snap.map) {
+		munmap(snap.map, snap.size);
+		snap.map = NULL;
+	}
+}
+
+static void _render_post_cb(void *data, Evas *e, void *event_info);
+
+static void _stop_waiting(void)
+{
+	if (snap.evas)
+		evas_event_callback_del_full(snap.evas,
+				EVAS_CALLBACK_RENDER_POST, _render_post_cb, NULL);
+	if (snap.shown) {
+		ecore_event_handler_del(snap.shown);
+		snap.shown = NULL;
+	}
+	DEL_TIMER(snap.timer)
+}
+
+static void _ready_job(void *data)
+{
+	snap.job = NULL;
+	if (snap.ready)
+		snap.ready(snap.data);
+	snap.ready = NULL;
+}
+
+/* the snapshot is on screen, or waiting took too long */
+static void _ready(void)
+{
+	if (snap.ready == NULL)
+		return;
+	_stop_waiting();
+	/* leave the render first, the build blocks for a while */
+	snap.job = ecore_job_add(_ready_job, NULL);
+}
+
+static Eina_Bool _shown_cb(void *data, int type, void *event)
+{
+	Ecore_X_Event_Window_Show *ev = event;
+
+	if (ev && ev->win == snap.xwin)
+		snap.mapped = 1;
+	return ECORE_CALLBACK_PASS_ON;
+}
+
+static void _render_post_cb(void *data, Evas *e, void *event_info)
+{
+	/* a frame drawn before the map may never reach the screen */
+	if (snap.mapped)
+		_ready();
+}
+
+static Eina_Bool _timeout_cb(void *data)
+{
+	snap.timer = NULL;
+	_D("no snapshot frame in %.0fms\n", SNAPSHOT_WAIT * 1000.0);
+	_ready();
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/* 0 when the snapshot is up and ready() will be called */
+int _snapshot_show(struct appdata *ad, int type, int level,
+		void (*ready)(void *data), void *data)
+{
+	char path[SNAPSHOT_PATH_SIZE];
+	struct snapshot_header *h;
+	struct stat st;
+	uint32_t key;
+	int fd;
+
+	retvm_if(ad == NULL || ad->win == NULL, -1, "Invalid argument\n");
+	retvm_if(ready == NULL, -1, "Invalid argument: ready is NULL\n");
+
+	/* the image of the last cold start is gone with the live frame */
+	if (snap.img == NULL)
+		_unmap();
+	key = _key(ad, type);
+	_path(key, path, sizeof(path));
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &st) < 0 || st.st_size < sizeof(*h)) {
+		close(fd);
+		return -1;
+	}
+	/* private: evas gets a writable buffer, the file stays as it is */
+	snap.map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (snap.map == MAP_FAILED) {
+		snap.map = NULL;
+		return -1;
+	}
+	snap.size = st.st_size;
+
+	h = snap.map;
+	if (h->magic != SNAPSHOT_MAGIC || h->version != SNAPSHOT_VERSION
+			|| h->key != key || h->w <= 0 || h->h <= 0
+			|| snap.size != sizeof(*h) + (size_t)h->w * h->h * 4) {
+		_E("Stale snapshot %s\n", path);
+		_unmap();
+		unlink(path);
+		return -1;
+	}
+
+	snap.evas = evas_object_evas_get(ad->win);
+	snap.img = evas_object_image_filled_add(snap.evas);
+	evas_object_image_alpha_set(snap.img, EINA_TRUE);
+	evas_object_image_size_set(snap.img, h->w, h->h);
+	evas_object_image_data_set(snap.img, h + 1);
+	evas_object_move(snap.img, h->x, h->y);
+	evas_object_resize(snap.img, h->w, h->h);
+	evas_object_show(snap.img);
+	snap.level = _add_level_overlay(ad->win, type, level, ad->step,
+			h->lx, h->ly, h->lw, h->lh);
+	if (snap.level == NULL) {
+		evas_object_del(snap.img);
+		snap.img = NULL;
+		_unmap();
+		return -1;
+	}
+
+	snap.xwin = ad->xwin;
+	snap.mapped = 0;
+	snap.ready = ready;
+	snap.data = data;
+	snap.shown = ecore_event_handler_add(ECORE_X_EVENT_WINDOW_SHOW,
+			_shown_cb, NULL);
+	evas_event_callback_add(snap.evas, EVAS_CALLBACK_RENDER_POST,
+			_render_post_cb, NULL);
+	ADD_TIMER(snap.timer, SNAPSHOT_WAIT, _timeout_cb, NULL)
+
+	evas_object_show(ad->win);
+	_D("snapshot %dx%d+%d+%d\n", h->w, h->h, h->x, h->y);
+	return 0;
+}
+
+/* the live widgets are shown, they replace the image on the next
+ * frame; or the popup is closed and nothing is built or captured */
+void _snapshot_drop(void)
+{
+	_stop_waiting();
+	snap.ready = NULL;
+	if (snap.job) {
+		ecore_job_del(snap.job);
+		snap.job = NULL;
+	}
+	DEL_TIMER(snap.settle)
+	if (snap.level) {
+		evas_object_del(snap.level);
+		snap.level = NULL;
+	}
+	if (snap.img) {
+		evas_object_del(snap.img);
+		snap.img = NULL;
+	}
+}
+
+/* box of the fully opaque pixels, the dim around the popup is not */
+static int _opaque_box(const unsigned char *px, int bpl, int w, int h,
+		int *bx, int *by, int *bw, int *bh)
+{
+	const uint32_t *row;
+	int x, y, x0 = w, y0 = h, x1 = -1, y1 = -1;
+
+	for (y = 0; y < h; y++) {
+		row = (const uint32_t *)(px + y * bpl);
+		for (x = 0; x < w; x++) {
+			if ((row[x] >> 24) != 0xff)
+				continue;
+			if (x < x0) x0 = x;
+			if (x > x1) x1 = x;
+			if (y < y0) y0 = y;
+			y1 = y;
+		}
+	}
+	if (x1 < 0)
+		return -1;
+	*bx = x0;
+	*by = y0;
+	*bw = x1 - x0 + 1;
+	*bh = y1 - y0 + 1;
+	return 0;
+}
+
+/* level box in window coordinates: the slider with its icon */
+static int _level_box(struct appdata *ad, int *x, int *y, int *w, int *h)
+{
+#if defined(FLAT_POPUP)
+	static const char *parts[] = { "icon", "level.base", "level.knob" };
+	int fx = 0, fy = 0, px, py, pw, ph, x1 = 0, y1 = 0, i;
+
+	if (ad->fl == NULL)
+		return -1;
+	evas_object_geometry_get(ad->fl, &fx, &fy, NULL, NULL);
+	for (i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+		if (!edje_object_part_geometry_get(ad->fl, parts[i],
+					&px, &py, &pw, &ph))
+			return -1;
+		px += fx;
+		py += fy;
+		if (i == 0 || px < *x) *x = px;
+		if (i == 0 || py < *y) *y = py;
+		if (i == 0 || px + pw > x1) x1 = px + pw;
+		if (i == 0 || py + ph > y1) y1 = py + ph;
+	}
+	/* the knob is confined to the base, the box holds all of it */
+	*w = x1 - *x;
+	*h = y1 - *y;
+#else
+	if (ad->sl == NULL)
+		return -1;
+	evas_object_geometry_get(ad->sl, x, y, w, h);
+#endif
+	return *w > 0 && *h > 0 ? 0 : -1;
+}
+
+/* paints the level box over with the row above it, or the row below */
+static void _blank_box(unsigned char *px, int bpl, struct snapshot_header *h)
+{
+	int x0, x1, y0, y1, y, src;
+
+	x0 = h->lx > h->x ? h->lx : h->x;
+	x1 = h->lx + h->lw < h->x + h->w ? h->lx + h->lw : h->x + h->w;
+	y0 = h->ly > h->y ? h->ly : h->y;
+	y1 = h->ly + h->lh < h->y + h->h ? h->ly + h->lh : h->y + h->h;
+	if (x0 >= x1 || y0 >= y1)
+		return;
+	if (y0 > h->y)
+		src = y0 - 1;
+	else if (y1 < h->y + h->h)
+		src = y1;
+	else
+		return;
+	for (y = y0; y < y1; y++)
+		memcpy(px + y * bpl + x0 * 4, px + src * bpl + x0 * 4,
+				(x1 - x0) * 4);
+}
+
+/* the popup is up, settled and looks like nothing on file yet */
+static int _capturable(struct appdata *ad, char *path, int size)
+{
+	if (ad->win == NULL || evas_object_visible_get(ad->win) == EINA_FALSE)
+		return 0;
+	if ((ad->pu == NULL && ad->fl == NULL) || ad->flag_warning
+			|| ad->flag_deleting)
+		return 0;
+	_path(_key(ad, ad->type), path, size);
+	return access(path, F_OK) < 0;
+}
+
+static int _capture(struct appdata *ad)
+{
+	char path[SNAPSHOT_PATH_SIZE], tmp[SNAPSHOT_PATH_SIZE];
+	struct snapshot_header h;
+	Ecore_X_Window_Attributes att;
+	Ecore_X_Image *im;
+	unsigned char *px;
+	int bpl, rows, bpp, y, ret = -1;
+	FILE *fp;
+
+	if (!_capturable(ad, path, sizeof(path)))
+		return 0;
+
+	memset(&h, 0, sizeof(h));
+	h.key = _key(ad, ad->type);
+	if (_level_box(ad, &h.lx, &h.ly, &h.lw, &h.lh) < 0)
+		return -1;
+
+	memset(&att, 0, sizeof(att));
+	if (!ecore_x_window_attributes_get(ad->xwin, &att) || att.depth != 32)
+		return -1;
+	im = ecore_x_image_new(att.w, att.h, att.visual, att.depth);
+	retvm_if(im == NULL, -1, "Failed to create image\n");
+	if (!ecore_x_image_get(im, ad->xwin, 0, 0, 0, 0, att.w, att.h))
+		goto out;
+	px = ecore_x_image_data_get(im, &bpl, &rows, &bpp);
+	if (px == NULL || bpp != 4 || rows < att.h)
+		goto out;
+	if (_opaque_box(px, bpl, att.w, att.h, &h.x, &h.y, &h.w, &h.h) < 0)
+		goto out;
+	_blank_box(px, bpl, &h);
+
+	h.magic = SNAPSHOT_MAGIC;
+	h.version = SNAPSHOT_VERSION;
+	snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+	fp = fopen(tmp, "w");
+	if (fp == NULL) {
+		_E("Failed to open %s\n", tmp);
+		goto out;
+	}
+	fwrite(&h, sizeof(h), 1, fp);
+	for (y = h.y; y < h.y + h.h; y++)
+		fwrite(px + y * bpl + h.x * 4, 4, h.w, fp);
+	if (fclose(fp) != 0 || rename(tmp, path) < 0) {
+		_E("Failed to write %s\n", path);
+		unlink(tmp);
+		goto out;
+	}
+	_D("snapshot saved %dx%d+%d+%d level box %dx%d+%d+%d\n",
+			h.w, h.h, h.x, h.y, h.lw, h.lh, h.lx, h.ly);
+	ret = 1;
+out:
+	ecore_x_image_free(im);
+	return ret;
+}
+
+static Eina_Bool _settle_cb(void *data)
+{
+	snap.settle = NULL;
+	_capture(data);
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/*
+ * Called once the popup is shown. A look already on file costs a stat;
+ * a new one is read back after SNAPSHOT_SETTLE, unless the popup hid.
+ */
+void _snapshot_capture(struct appdata *ad)
+{
+	char path[SNAPSHOT_PATH_SIZE];
+
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+	if (snap.settle || !_capturable(ad, path, sizeof(path)))
+		return;
+	ADD_TIMER(snap.settle, SNAPSHOT_SETTLE, _settle_cb, ad)
+}
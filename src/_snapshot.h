@@ -0,0 +1,44 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef __VOLUME_SNAPSHOT_H__
+#define __VOLUME_SNAPSHOT_H__
+
+#include <stdint.h>
+
+#include "volume.h"
+
+#define SNAPSHOT_MAGIC 0x50414e53	/* "SNAP" */
+#define SNAPSHOT_VERSION 3
+
+/* raw file: the header, then h rows of w premultiplied ARGB pixels */
+struct snapshot_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t key;
+	int32_t x, y, w, h;
+	int32_t lx, ly, lw, lh;	/* level box, blank: drawn live */
+};
+
+int _snapshot_show(struct appdata *ad, int type, int level,
+		void (*ready)(void *data), void *data);
+void _snapshot_drop(void);
+void _snapshot_capture(struct appdata *ad);
+
+#endif
+/* __VOLUME_SNAPSHOT_H__ */
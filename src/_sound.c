@@ -15,47 +15,91 @@
  */
 
 
+#include <alloca.h>
 #include <appcore-common.h>
 #include <mm_sound.h>
 #include <vconf.h>
-#include <svi.h>
 
 #include "volume.h"
 #include "_util_log.h"
 #include "_logic.h"
+#include "_state.h"
+#include "_vmem.h"
+#include "_notify.h"
+#include "_catalog.h"
+#include "_input.h"
+#include "_backend.h"
+#include "_level.h"
+#include "_record.h"
+#include "_trace.h"
+#include "_stats.h"
+#include "_wakeup.h"
+#include "_lazy.h"
+#include "_util_efl.h"
 
 #define STRBUF_SIZE 64
 #define PATHBUF_SIZE 256
 
-void _play_vib(int handle)
+/*
+ * svi is opened and initialized by the first feedback that plays, not
+ * at launch: media launches and launches closed without a key never
+ * play one. Without svi the feedback is silent, the level still changes.
+ */
+enum {
+	FEEDBACK_UNTRIED = 0,
+	FEEDBACK_READY,
+	FEEDBACK_FAILED,
+};
+
+static int _svi_handle(int *handle)
 {
-	svi_play_vib(handle, SVI_VIB_OPERATION_VIBRATION);
+	static int state = FEEDBACK_UNTRIED;
+	static int sh;
+
+	if (state == FEEDBACK_UNTRIED) {
+		state = FEEDBACK_FAILED;
+		if (_lazy_svi_load() == 0) {
+			if (lazy_svi.svi_init(&sh) == SVI_SUCCESS) {
+				state = FEEDBACK_READY;
+			} else {
+				_E("Failed to init svi\n");
+				lazy_svi.svi_fini(sh);
+			}
+		}
+	}
+	*handle = sh;
+	return state == FEEDBACK_READY ? 0 : -1;
 }
 
-void _play_sound(int type, int handle)
+void _play_vib(void)
 {
-	if (type == VOLUME_TYPE_MEDIA) {
+	int handle;
 
-	} else {
-		svi_play_sound(handle, SVI_SND_TOUCH_TOUCH1);
-	}
+	if (_svi_handle(&handle) == 0)
+		lazy_svi.svi_play_vib(handle, SVI_VIB_OPERATION_VIBRATION);
 }
 
-int _init_svi(void *data)
+void _play_sound(int type)
 {
-	int ret, handle;
+	int handle;
 
-	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, -1, "Invaild argument: appdata is NULL\n");
+	if (type == VOLUME_TYPE_MEDIA)
+		return;
+	if (_svi_handle(&handle) == 0)
+		lazy_svi.svi_play_sound(handle, SVI_SND_TOUCH_TOUCH1);
+}
 
-	ret = svi_init(&handle);
-	if (ret != SVI_SUCCESS) {
-		_E("Failed to init svi\n");
-		svi_fini(handle);
-		return -1;
-	}
-	ad->sh = handle;
-	return 0;
+int _get_sound_status(void)
+{
+	int snd = 0;
+
+	vconf_get_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, &snd);
+	return snd;
+}
+
+void _set_sound_status(int on)
+{
+	vconf_set_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, on ? EINA_TRUE : EINA_FALSE);
 }
 
 int _set_slider_value(void *data, int val)
@@ -63,10 +107,18 @@ int _set_slider_value(void *data, int val)
 	struct appdata *ad = (struct appdata *)data;
 	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
 
-	if (ad->flag_touching == EINA_TRUE) {
+	/* the finger owns the slider while dragging */
+	if (ad->input_mode == INPUT_TOUCH) {
 		return 0;
 	}
-	if (ad->sl) {
+	if (ad->fl) {
+		Edje_Message_Int_Set *msg;
+		msg = alloca(sizeof(Edje_Message_Int_Set) + sizeof(int));
+		msg->count = 2;
+		msg->val[0] = val;
+		msg->val[1] = ad->step;
+		edje_object_message_send(ad->fl, EDJE_MESSAGE_INT_SET, 1, msg);
+	} else if (ad->sl) {
 		elm_slider_min_max_set(ad->sl, 0, ad->step);
 		elm_slider_value_set(ad->sl, val);
 	}
@@ -74,83 +126,332 @@ int _set_slider_value(void *data, int val)
 	return 0;
 }
 
-int _set_icon(void *data, int val)
+double _get_slider_value(void *data)
 {
-	int snd=0, vib=0;
-	char buf[PATHBUF_SIZE] = {0, };
-	char *img;
+	double dx = 0.0;
 	struct appdata *ad = (struct appdata *)data;
-	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
+	retvm_if(ad == NULL, 0.0, "Invalid argument: appdata is NULL\n");
+
+	if (ad->fl) {
+		edje_object_part_drag_value_get(ad->fl, "level.knob", &dx, NULL);
+		return dx * ad->step;
+	}
+	if (ad->sl)
+		return elm_slider_value_get(ad->sl);
+	return 0.0;
+}
+
+/* the popup is created once, so what it shows is kept here */
+static const char *icon_shown;
+static char title_shown[STRBUF_SIZE];
+
+/* the icon for a level, and the flat popup signal that shows it */
+static const char *_pick_icon(int type, int val, const char **sig, int *vib)
+{
+	int snd=0, vibrate=0;
+	const char *img;
 
 	vconf_get_bool(VCONFKEY_SETAPPL_SOUND_STATUS_BOOL, &snd);
-	vconf_get_bool(VCONFKEY_SETAPPL_VIBRATION_STATUS_BOOL, &vib);
+	vconf_get_bool(VCONFKEY_SETAPPL_VIBRATION_STATUS_BOOL, &vibrate);
+	*vib = 0;
 
 	if (val == 0) {
-		if (vib) {
-			if (ad->type == VOLUME_TYPE_MEDIA) {
+		if (vibrate) {
+			if (type == VOLUME_TYPE_MEDIA) {
 				_D("media and mute\n");
 				img = "00_volume_icon_Mute.png";
+				*sig = "icon,mute";
 			} else {
 				_D("Not media and vib\n");
 				img = "00_volume_icon_Vibrat.png";
-				_play_vib(ad->sh);
+				*sig = "icon,vib";
+				*vib = 1;
 			}
 		} else {
 			_D("vib\n");
 			img = "00_volume_icon_Mute.png";
+			*sig = "icon,mute";
 		}
 	} else {
 		_D("default volume\n");
 		img = "00_volume_icon.png";
+		*sig = "icon,default";
 	}
 
 	if(!snd){
-		if(ad->type != VOLUME_TYPE_MEDIA){
+		if(type != VOLUME_TYPE_MEDIA){
 			_D("Not media and mute\n");
 			img = "00_volume_icon_Mute.png";
+			*sig = "icon,mute";
 		}
 	}
+	return img;
+}
+
+int _set_icon(void *data, int val)
+{
+	int vib;
+	char buf[PATHBUF_SIZE] = {0, };
+	const char *img, *sig;
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
+
+	img = _pick_icon(ad->type, val, &sig, &vib);
+	if (vib)
+		_play_vib();
+
+	/* same icon as shown: no image decode, no path string */
+	if (img == icon_shown) {
+		_stats_inc(STATS_ICON_SKIP);
+		return 0;
+	}
 
+	if (ad->fl) {
+		edje_object_signal_emit(ad->fl, sig, "volume");
+		icon_shown = img;
+		_stats_inc(STATS_ICON_RELOAD);
+		return 1;
+	}
 
 	snprintf(buf, sizeof(buf), "%s/%s", IMAGEDIR, img);
 	if (ad->ic ) {
 		elm_icon_file_set(ad->ic, buf, NULL);
+		icon_shown = img;
+		_stats_inc(STATS_ICON_RELOAD);
 	}
 	return 1;
 }
 
+#if defined(FLAT_POPUP)
+static void _clip_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+	evas_object_del(data);
+}
+#endif
+
+/*
+ * The level part of a snapshot: the slider and its icon, drawn live at
+ * x,y wxh over an image that holds everything else. It shares no state
+ * with the popup, so the build that replaces it still sets the icon.
+ */
+Evas_Object *_add_level_overlay(Evas_Object *win, int type, int val, int step,
+		int x, int y, int w, int h)
+{
+	int vib;
+	const char *sig;
+#if defined(FLAT_POPUP)
+	Evas_Object *fl, *clip;
+	Edje_Message_Int_Set *msg;
+	int ww = 0, wh = 0;
+
+	retvm_if(win == NULL, NULL, "Invalid argument: window is NULL\n");
+	_pick_icon(type, val, &sig, &vib);
+
+	/* the whole group for the layout, clipped to the level box */
+	fl = _add_edje(win, EDJ_THEME, GRP_VOLUME_FLAT);
+	retvm_if(fl == NULL, NULL, "Failed to add level overlay\n");
+	evas_object_geometry_get(win, NULL, NULL, &ww, &wh);
+	evas_object_move(fl, 0, 0);
+	evas_object_resize(fl, ww, wh);
+	msg = alloca(sizeof(Edje_Message_Int_Set) + sizeof(int));
+	msg->count = 2;
+	msg->val[0] = val;
+	msg->val[1] = step;
+	edje_object_message_send(fl, EDJE_MESSAGE_INT_SET, 1, msg);
+	edje_object_signal_emit(fl, sig, "volume");
+
+	clip = evas_object_rectangle_add(evas_object_evas_get(win));
+	evas_object_move(clip, x, y);
+	evas_object_resize(clip, w, h);
+	evas_object_clip_set(fl, clip);
+	evas_object_event_callback_add(fl, EVAS_CALLBACK_DEL, _clip_del_cb, clip);
+	evas_object_show(clip);
+	evas_object_show(fl);
+	return fl;
+#else
+	Evas_Object *sl, *ic;
+	const char *img;
+	char buf[PATHBUF_SIZE] = {0, };
+
+	retvm_if(win == NULL, NULL, "Invalid argument: window is NULL\n");
+	img = _pick_icon(type, val, &sig, &vib);
+
+	sl = _add_slider(win, 0, step, val);
+	retvm_if(sl == NULL, NULL, "Failed to add level overlay\n");
+	ic = elm_icon_add(sl);
+	evas_object_size_hint_aspect_set(ic, EVAS_ASPECT_CONTROL_VERTICAL, 1, 1);
+	elm_icon_resizable_set(ic, EINA_FALSE, EINA_FALSE);
+	snprintf(buf, sizeof(buf), "%s/%s", IMAGEDIR, img);
+	elm_icon_file_set(ic, buf, NULL);
+	elm_object_part_content_set(sl, "icon", ic);
+
+	evas_object_move(sl, x, y);
+	evas_object_resize(sl, w, h);
+	evas_object_show(sl);
+	return sl;
+#endif
+}
+
+/*
+ * Warning text per language. The label stays swallowed in the warning
+ * layout, which stays the popup content, and showing the warning only
+ * switches the layout state. The label keeps its shaped layout as long
+ * as neither its text nor its own width change, so the text is only set
+ * again when the language or the label width is different from what it
+ * was last laid out with.
+ */
+#define WARN_CACHE_MAX 4
+#define WARN_LANG_SIZE 16
+#define WARN_TEXT_SIZE 512
+
+struct warn_text {
+	char lang[WARN_LANG_SIZE];
+	char markup[WARN_TEXT_SIZE];
+};
+
+static struct warn_text warn_cache[WARN_CACHE_MAX];
+static int warn_next;
+static int warn_sel = -1;	/* entry of the current language */
+static int warn_shown = -1;	/* entry the label is laid out with */
+static int warn_width = -1;	/* label width it is laid out at */
+static Evas_Object *warn_watched;
+static unsigned int warn_hits, warn_misses, warn_wraps, warn_shows;
+static double warn_layout_ms, warn_show_ms;
+
+static int _select_warning_text(const char *lang)
+{
+	int i;
+
+	for (i = 0; i < WARN_CACHE_MAX; i++) {
+		if (warn_cache[i].lang[0] && !strcmp(warn_cache[i].lang, lang))
+			return i;
+	}
+
+	i = warn_next;
+	warn_next = (warn_next + 1) % WARN_CACHE_MAX;
+	if (i == warn_shown)
+		warn_shown = -1;
+	snprintf(warn_cache[i].lang, WARN_LANG_SIZE, "%s", lang);
+	snprintf(warn_cache[i].markup, WARN_TEXT_SIZE,
+			"<font_size=32><b>%s</b></font_size>",
+			_catalog_text(CATALOG_WARNING_HEARING));
+	return i;
+}
+
+/* the label wraps again by itself when resized */
+static void _warning_resize_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+	int w = 0;
+
+	evas_object_geometry_get(obj, NULL, NULL, &w, NULL);
+	if (w == warn_width)
+		return;
+	warn_width = w;
+	warn_wraps++;
+}
+
+static int _warning_width(struct appdata *ad)
+{
+	int w = 0;
+
+	if (ad->fl)
+		edje_object_part_geometry_get(ad->fl, "warning", NULL, NULL, &w, NULL);
+	else
+		evas_object_geometry_get(ad->warn_lb, NULL, NULL, &w, NULL);
+	return w;
+}
+
+void _set_warning_text(void *data, const char *lang)
+{
+	int w;
+	double t, ms;
+	struct warn_text *wt;
+	struct appdata *ad = (struct appdata *)data;
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
+
+	if (lang)
+		warn_sel = _select_warning_text(lang);
+	else if (warn_sel < 0)
+		warn_sel = _select_warning_text("");
+	wt = &warn_cache[warn_sel];
+
+	if (ad->fl == NULL && ad->warn_lb == NULL)
+		return;
+
+	if (ad->warn_lb && ad->warn_lb != warn_watched) {
+		evas_object_event_callback_add(ad->warn_lb, EVAS_CALLBACK_RESIZE,
+				_warning_resize_cb, NULL);
+		warn_watched = ad->warn_lb;
+	}
+
+	w = _warning_width(ad);
+	if (warn_sel == warn_shown && w == warn_width) {
+		warn_hits++;
+		return;
+	}
+
+	/* lay out only the label, the rest of the canvas waits for render */
+	t = ecore_time_get();
+	if (ad->fl) {
+		edje_object_part_text_set(ad->fl, "warning",
+				_catalog_text(CATALOG_WARNING_HEARING));
+		edje_object_calc_force(ad->fl);
+	} else {
+		elm_object_text_set(ad->warn_lb, wt->markup);
+		evas_object_smart_calculate(ad->warn_lb);
+	}
+	ms = (ecore_time_get() - t) * 1000.0;
+	warn_layout_ms += ms;
+	warn_shown = warn_sel;
+	warn_width = _warning_width(ad);
+	warn_misses++;
+	_D("warning text laid out for %s width(%d) in %.3fms\n", wt->lang, warn_width, ms);
+}
+
+void _warning_text_dump(void)
+{
+	_D("warning text reused(%u) laid out(%u) in %.3fms, wrapped on resize(%u)\n",
+			warn_hits, warn_misses, warn_layout_ms, warn_wraps);
+	_D("warning shown(%u) in %.3fms\n", warn_shows, warn_show_ms);
+}
+
 void _set_device_warning(void *data, int val, int device)
 {
+	double t;
 	struct appdata *ad = (struct appdata *)data;
 	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
 
-	switch (device) {
-		case SYSTEM_AUDIO_ROUTE_PLAYBACK_DEVICE_EARPHONE:
-			if (val >= 13) {
-				if(ad->flag_warning) return;
-				ad->flag_warning = true;
-				elm_object_content_unset(ad->pu);
-				elm_object_part_content_set(ad->warn_ly, "elm.swallow.slider1", ad->sl);
-				elm_object_content_set(ad->pu, ad->warn_ly);
-				evas_object_show(ad->warn_ly);
-				DEL_TIMER(ad->warntimer);
-				ADD_TIMER(ad->warntimer, 3.0, _unset_layout, data);
-			}
-			else {
-				ad->flag_warning = false;
-				_unset_layout(data);
-			}
-			break;
-		default:
-			ad->flag_warning = false;
-			_unset_layout(data);
-			break;
+	if (!_level_warning(val, device)) {
+		ad->flag_warning = false;
+		_unset_layout(data);
+		return;
 	}
+
+	if(ad->flag_warning) return;
+	ad->flag_warning = true;
+	_set_warning_text(ad, NULL);
+	_stats_inc(STATS_WARNING_SWAP);
+
+	/* the state change and the relayout it causes, timed together */
+	t = ecore_time_get();
+	if (ad->fl) {
+		edje_object_signal_emit(ad->fl, "warning,show", "volume");
+		edje_object_calc_force(ad->fl);
+	} else {
+		elm_object_signal_emit(ad->warn_ly, "warning,show", "volume");
+		edje_object_calc_force(elm_layout_edje_get(ad->warn_ly));
+		evas_object_smart_calculate(ad->warn_lb);
+	}
+	warn_show_ms += (ecore_time_get() - t) * 1000.0;
+	warn_shows++;
+
+	DEL_TIMER(ad->warntimer);
+	ADD_TIMER(ad->warntimer, 3.0, _unset_layout, data);
 }
 
 int _get_title(volume_type_t type, char *label, int size)
 {
-	char *text = NULL;
+	const char *text = NULL;
 
 	text = S_("IDS_COM_BODY_UNKNOWN");
 
@@ -168,17 +469,17 @@ int _get_title(volume_type_t type, char *label, int size)
 		text = S_("IDS_COM_BODY_RINGTONE");
 		break;
 	case VOLUME_TYPE_MEDIA:
-		text = T_("IDS_COM_BODY_MEDIA");
+		text = _catalog_text(CATALOG_MEDIA);
 		break;
 	case VOLUME_TYPE_CALL:
 		text = S_("IDS_COM_BODY_CALL");
 		break;
 	case VOLUME_TYPE_EXT_ANDROID:
 		/* this enum is different from mm_sound.h and avsys-audio.h */
-		text = T_("IDS_COM_BODY_ANDROID");
+		text = _catalog_text(CATALOG_ANDROID);
 		break;
 	case VOLUME_TYPE_EXT_JAVA:
-		text = T_("IDS_COM_BODY_JAVA");
+		text = _catalog_text(CATALOG_JAVA);
 		break;
 	default:
 		text = S_("IDS_COM_BODY_SYSTEM");
@@ -201,84 +502,150 @@ void _set_popup_title(void *data, int type, int device)
 
 	switch (device) {
 		case SYSTEM_AUDIO_ROUTE_PLAYBACK_DEVICE_EARPHONE:
-			snprintf(name, sizeof(name), "%s (%s)", buf, T_("IDS_COM_OPT_HEADPHONES_ABB"));
-			elm_object_part_text_set(ad->pu, "title,text", name);
+			snprintf(name, sizeof(name), "%s (%s)", buf, _catalog_text(CATALOG_HEADPHONES));
 			break;
 		default:
-			elm_object_part_text_set(ad->pu, "title,text", buf);
+			snprintf(name, sizeof(name), "%s", buf);
 			break;
 	}
+
+	/* unchanged unless the type, the route or the language changed */
+	if (!strcmp(name, title_shown)) {
+		_stats_inc(STATS_TITLE_SKIP);
+		return;
+	}
+	snprintf(title_shown, sizeof(title_shown), "%s", name);
+
+	if (ad->fl)
+		edje_object_part_text_set(ad->fl, "title", name);
+	else
+		elm_object_part_text_set(ad->pu, "title,text", name);
 }
 
-int _get_step(int type)
+static void _update_state(int type, int val, int step, int device)
 {
-	int ret, step;
-	ret = mm_sound_volume_get_step(type, &step);
-	retvm_if(ret < 0, -1, "Failed to get step\n");
-	step -= 1;
-	return step;
+	_state_publish(type, val, step, device, val == 0);
+	_vmem_store(device, type, val);
+	_level_sync(type, val);
 }
 
 void _mm_func(void *data)
 {
 	_D("%s\n", __func__);
 	int val;
+	double t;
 	system_audio_route_device_t device = 0;
 	struct appdata *ad = (struct appdata *)data;
 	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
 
 	retm_if(ad->win == NULL, "Failed to get window\n");
+	/* a cold launch showing its snapshot syncs the view once built */
+	if (ad->pu == NULL && ad->fl == NULL)
+		return;
 
+	t = ecore_time_get();
+	_trace_begin(TRACE_VIEW);
 	/* function could be activated when window exists */
-	ad->step = _get_step(ad->type);
-	mm_sound_volume_get_value(ad->type, (unsigned int*)(&val));
-	mm_sound_route_get_playing_device(&device);
+	ad->step = _level_max(ad->type);
+	_level_read(ad->type, &val);
+	device = _backend_get_route();
+	_update_state(ad->type, val, ad->step, device);
 
 	_set_slider_value(ad, val);
 	_set_popup_title(ad, ad->type, device);
 	_set_device_warning(ad, val, device);
 	_set_icon(ad, val);
-	_D("type(%d) val(%d)\n", ad->type, val);
+	_trace_end(TRACE_VIEW);
+	_D("type(%d) val(%d) view(%.3fms)\n", ad->type, val,
+			(ecore_time_get() - t) * 1000.0);
 }
 
-void _mm_system_cb(void *data)
+static void _mm_type_func(struct appdata *ad, volume_type_t type)
 {
-	_mm_func(data);
-}
+	int val = 0, step;
+	struct volume_state st;
+	system_audio_route_device_t device = 0;
 
-void _mm_notification_cb(void *data)
-{
-	_mm_func(data);
-}
+	if (type == ad->type) {
+		if (ad->win && evas_object_visible_get(ad->win) == EINA_TRUE) {
+			_stats_inc(STATS_VIEW_UPDATE);
+			_mm_func(ad);
+			return;
+		}
+		/* dormant: the show path syncs the view once */
+		_stats_inc(STATS_VIEW_DORMANT);
+	}
 
-void _mm_alarm_cb(void *data)
-{
-	_mm_func(data);
+	/* background stream or hidden popup: refresh the published state only */
+	if (_state_get(type, &st) == 0)
+		step = st.step;
+	else
+		step = _level_max(type);
+	_level_read(type, &val);
+	device = _backend_get_route();
+	_update_state(type, val, step, device);
+	_D("background type(%d) val(%d)\n", type, val);
 }
 
-void _mm_ringtone_cb(void *data)
+struct mm_cb_data {
+	struct appdata *ad;
+	volume_type_t type;
+};
+
+static struct mm_cb_data mm_cb_table[] = {
+	{ NULL, VOLUME_TYPE_SYSTEM },
+	{ NULL, VOLUME_TYPE_NOTIFICATION },
+	{ NULL, VOLUME_TYPE_ALARM },
+	{ NULL, VOLUME_TYPE_RINGTONE },
+	{ NULL, VOLUME_TYPE_MEDIA },
+	{ NULL, VOLUME_TYPE_CALL },
+	{ NULL, VOLUME_TYPE_EXT_ANDROID },
+	{ NULL, VOLUME_TYPE_EXT_JAVA },
+};
+
+static struct notify_queue mm_queue;
+static Ecore_Pipe *mm_pipe = NULL;
+
+/* main loop: apply the notifications queued since the last wakeup */
+static void _mm_pipe_cb(void *data, void *buf, unsigned int nbyte)
 {
-	_mm_func(data);
-}
+	int type;
+	struct appdata *ad = (struct appdata *)data;
+	retm_if(ad == NULL, "Invalid argument: appdata is NULL\n");
 
-void _mm_media_cb(void *data)
-{
-	_mm_func(data);
+	WAKEUP_BEGIN("mm_sound pipe");
+	_notify_rearm(&mm_queue);
+	while (_notify_pop(&mm_queue, &type) == 0) {
+		_record(REC_NOTIFY, type);
+		_stats_inc(STATS_MM_NOTIFY);
+		_mm_type_func(ad, type);
+	}
+	WAKEUP_END();
 }
 
-void _mm_call_cb(void *data)
+/* mm_sound thread: never touch the view from here */
+static void _mm_cb(void *data)
 {
-	_mm_func(data);
-}
+	char c = 0;
+	struct mm_cb_data *cb = (struct mm_cb_data *)data;
+	if (cb == NULL || mm_pipe == NULL)
+		return;
 
-void _mm_ext_android_cb(void *data)
-{
-	_mm_func(data);
+	if (_notify_push(&mm_queue, cb->type) > 0)
+		ecore_pipe_write(mm_pipe, &c, sizeof(c));
 }
 
-void _mm_ext_java_cb(void *data)
+/* queue a notification as if mm_sound had sent it */
+void _mm_notify(volume_type_t type)
 {
-	_mm_func(data);
+	int i;
+
+	for (i = 0; i < sizeof(mm_cb_table) / sizeof(mm_cb_table[0]); i++) {
+		if (mm_cb_table[i].type == type) {
+			_mm_cb(&mm_cb_table[i]);
+			return;
+		}
+	}
 }
 
 int _get_volume_type_max(void)
@@ -286,39 +653,65 @@ int _get_volume_type_max(void)
 	return VOLUME_TYPE_MAX;
 }
 
-int _init_mm_sound(void *data)
+int _restore_route_levels(void *data)
 {
+	int type, route, val, cur;
 	struct appdata *ad = (struct appdata *)data;
 	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
 
-	mm_sound_volume_add_callback(VOLUME_TYPE_SYSTEM,
-			_mm_system_cb, (void *)ad);
-	mm_sound_volume_add_callback(VOLUME_TYPE_NOTIFICATION,
-			_mm_notification_cb, (void *)ad);
-	mm_sound_volume_add_callback(VOLUME_TYPE_ALARM,
-			_mm_alarm_cb, (void *)ad);
-	mm_sound_volume_add_callback(VOLUME_TYPE_RINGTONE,
-			_mm_ringtone_cb, (void *)ad);
-	mm_sound_volume_add_callback(VOLUME_TYPE_MEDIA,
-			_mm_media_cb, (void *)ad);
-	mm_sound_volume_add_callback(VOLUME_TYPE_CALL,
-			_mm_call_cb, (void *)ad);
-	mm_sound_volume_add_callback(VOLUME_TYPE_EXT_ANDROID,
-			_mm_ext_android_cb, (void *)ad);
-	mm_sound_volume_add_callback(VOLUME_TYPE_EXT_JAVA,
-			_mm_ext_java_cb, (void *)ad);
-
-	return 0;
+	route = _backend_get_route();
+	if (route == ad->route)
+		return 0;
+	_D("route changed %d -> %d\n", ad->route, route);
+	ad->route = route;
+
+	/* one pass over every type remembered for the new route */
+	for (type = 0; type < VOLUME_TYPE_MAX; type++) {
+		if (_vmem_get(route, type, &val) < 0)
+			continue;
+		cur = -1;
+		_level_read(type, &cur);
+		if (cur == val)
+			continue;
+		/* the device moved again, the next earjack change restores */
+		if (_backend_get_route() != route) {
+			_E("route changed during restore\n");
+			break;
+		}
+		_level_set(type, val);
+	}
+	return 1;
 }
 
-int _get_sound_level(volume_type_t type, int *val)
+/* from the level cache, the startup probe filled it */
+void _publish_state_all(int device)
 {
-	mm_sound_volume_get_value(type, (unsigned int*)val);
-	return 0;
+	int type, val;
+
+	for (type = 0; type < VOLUME_TYPE_MAX; type++) {
+		if (_level_get(type, &val) < 0)
+			continue;
+		_update_state(type, val, _level_max(type), device);
+	}
 }
 
-int _set_sound_level(volume_type_t type, int val)
+int _init_mm_sound(void *data)
 {
-	mm_sound_volume_set_value(type, val);
+	int i;
+	struct appdata *ad = (struct appdata *)data;
+	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
+
+	/* registered once, the callbacks stay for the process lifetime */
+	if (mm_pipe != NULL)
+		return 0;
+	mm_pipe = ecore_pipe_add(_mm_pipe_cb, ad);
+	retvm_if(mm_pipe == NULL, -1, "Failed to add pipe\n");
+
+	for (i = 0; i < sizeof(mm_cb_table) / sizeof(mm_cb_table[0]); i++) {
+		mm_cb_table[i].ad = ad;
+		_backend_add_callback(mm_cb_table[i].type,
+				_mm_cb, (void *)&mm_cb_table[i]);
+	}
+
 	return 0;
 }
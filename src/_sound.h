@@ -20,17 +20,24 @@
 
 #include <mm_sound.h>
 
-int _init_svi();
 int _init_mm_sound(void *data);
 int _get_volume_type_max(void);
 int _get_title(volume_type_t type, char *label, int size);
-int _get_sound_level(volume_type_t type, int *val);
-int _get_step(int type);
-void _play_vib(int handle);
-void _play_sound(int type, int handle);
+void _play_vib(void);
+void _play_sound(int type);
+int _get_sound_status(void);
+void _set_sound_status(int on);
 void _mm_func(void *data);
+void _mm_notify(volume_type_t type);
+void _publish_state_all(int device);
+int _restore_route_levels(void *data);
 int _set_icon(void * data, int val);
-int _set_sound_level(volume_type_t type, int val);
+Evas_Object *_add_level_overlay(Evas_Object *win, int type, int val, int step,
+		int x, int y, int w, int h);
+int _set_slider_value(void *data, int val);
+double _get_slider_value(void *data);
+void _set_warning_text(void *data, const char *lang);
+void _warning_text_dump(void);
 
 #endif
 /* __VOLUME_SOUND_H__ */
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "volume.h"
+#include "_util_log.h"
+#include "_logic.h"
+#include "_sound.h"
+#include "_state.h"
+#include "_vmem.h"
+#include "_startup.h"
+#include "_backend.h"
+#include "_level.h"
+#include "_trace.h"
+
+/*
+ * Backend probes run on a worker thread while the main thread creates
+ * the window. The first _app_reset() joins the worker once the launch
+ * is admitted, or during admission when no cache knows the playing type.
+ *
+ * The worker only reads: it prefetches the theme and asks the servers,
+ * into struct probe alone. Everything shared with the main loop, the
+ * level cache, the volume memory and the published state, is written
+ * by the main thread after the join, so each keeps a single writer.
+ */
+
+#define VMEM_FILE DATADIR"/.volume_memory"
+
+struct probe {
+	pthread_t tid;
+	int started;
+	int joined;
+	int taken;
+	int stale;	/* the launch it served ended without it */
+
+	int lock;
+	int type;
+	int val;
+	int step;
+	int route;
+	int level[VOLUME_TYPE_MAX];	/* -1 when the read failed */
+	int steps[VOLUME_TYPE_MAX];	/* 0 when the read failed */
+
+	double t_start;
+	double t_probe;		/* time spent on the worker */
+	double t_join;		/* main thread time from start to join */
+	double t_wait;		/* main thread time blocked in join */
+};
+
+static struct probe probe;
+
+static double _now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void _prefetch(const char *path)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return;
+	/* only warm the page cache, edje itself is not thread safe */
+	posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+	close(fd);
+}
+
+static void *_probe_thread(void *data)
+{
+	double t = _now();
+	int i;
+
+	_prefetch(EDJ_THEME);
+
+	probe.lock = _get_vconf_idlelock();
+	probe.type = _get_volume_type();
+	probe.route = _backend_get_route();
+	for (i = 0; i < VOLUME_TYPE_MAX; i++) {
+		if (_backend_get_level(i, &probe.level[i]) < 0)
+			probe.level[i] = -1;
+		if (_backend_get_step(i, &probe.steps[i]) < 0)
+			probe.steps[i] = 0;
+	}
+	if (probe.type >= 0 && probe.type < VOLUME_TYPE_MAX) {
+		probe.val = probe.level[probe.type];
+		probe.step = probe.steps[probe.type] - 1;
+	}
+
+	probe.t_probe = _now() - t;
+	return NULL;
+}
+
+/* main thread, once the worker is done */
+static void _probe_apply(struct appdata *ad)
+{
+	int i;
+
+	/* steps are fixed, levels and route may have moved since */
+	for (i = 0; i < VOLUME_TYPE_MAX; i++) {
+		_level_sync_max(i, probe.steps[i] - 1);
+		if (!probe.stale && probe.level[i] >= 0)
+			_level_sync(i, probe.level[i]);
+	}
+	ad->route = probe.stale ? _backend_get_route() : probe.route;
+
+	_vmem_init(VMEM_FILE);
+	if (_state_init() == 0)
+		_publish_state_all(ad->route);
+}
+
+int _startup_probe_start(struct appdata *ad)
+{
+	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
+
+	probe.t_start = _now();
+	if (pthread_create(&probe.tid, NULL, _probe_thread, ad) != 0) {
+		_E("Failed to start probe thread, probing inline\n");
+		_probe_thread(ad);
+		_probe_apply(ad);
+		probe.joined = 1;
+	}
+	probe.started = 1;
+	return 0;
+}
+
+int _startup_probe_join(struct appdata *ad)
+{
+	double t;
+
+	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
+	if (!probe.started)
+		return -1;
+	if (probe.joined)
+		return 0;
+
+	_trace_begin(TRACE_JOIN);
+	t = _now();
+	probe.t_join = t - probe.t_start;
+	pthread_join(probe.tid, NULL);
+	probe.t_wait = _now() - t;
+	probe.joined = 1;
+	_probe_apply(ad);
+	_trace_end(TRACE_JOIN);
+
+	_D("startup probe(%.1fms) main until join(%.1fms) waited(%.1fms)\n",
+			probe.t_probe, probe.t_join, probe.t_wait);
+	return 0;
+}
+
+/*
+ * A launch that ends before joining, e.g. a rejected one, leaves the
+ * probe to a later launch. Nothing follows the levels until the join,
+ * so that launch reads them again instead of taking the probed ones.
+ */
+void _startup_probe_expire(void)
+{
+	if (probe.started)
+		probe.stale = 1;
+}
+
+/* Results of the probe are valid for the launch it started with only. */
+int _startup_probe_take(int *lock, int *type, int *val, int *step)
+{
+	if (!probe.joined || probe.taken || probe.stale)
+		return -1;
+	probe.taken = 1;
+
+	*lock = probe.lock;
+	*type = probe.type;
+	*val = probe.val;
+	*step = probe.step;
+	return 0;
+}
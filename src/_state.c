@@ -0,0 +1,117 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <mm_sound.h>
+
+#include "_util_log.h"
+#include "volume_state.h"
+#include "_state.h"
+
+static struct volume_state_shm *shm = NULL;
+
+int _state_init(void)
+{
+	struct volume_state_entry *e;
+	int fd, i;
+	void *p;
+
+	if (shm)
+		return 0;
+
+	fd = shm_open(VOLUME_STATE_SHM_NAME, O_RDWR | O_CREAT, 0644);
+	retvm_if(fd < 0, -1, "Failed to open %s\n", VOLUME_STATE_SHM_NAME);
+
+	if (ftruncate(fd, sizeof(struct volume_state_shm)) < 0) {
+		_E("Failed to size %s\n", VOLUME_STATE_SHM_NAME);
+		close(fd);
+		return -1;
+	}
+
+	p = mmap(NULL, sizeof(struct volume_state_shm), PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0);
+	close(fd);
+	retvm_if(p == MAP_FAILED, -1, "Failed to map %s\n", VOLUME_STATE_SHM_NAME);
+
+	shm = p;
+	/* readers check magic last, so fill the header before it */
+	shm->magic = 0;
+	__sync_synchronize();
+	/* the segment may outlive a restart with readers attached: seq only
+	 * grows, so a reader holding an old even value retries */
+	for (i = 0; i < VOLUME_STATE_TYPE_MAX; i++) {
+		e = &shm->entry[i];
+		if (!(e->seq & 1))
+			e->seq++;
+		__sync_synchronize();
+		memset(&e->st, 0, sizeof(e->st));
+		__sync_synchronize();
+		e->seq++;
+	}
+	shm->count = VOLUME_TYPE_MAX < VOLUME_STATE_TYPE_MAX ?
+		VOLUME_TYPE_MAX : VOLUME_STATE_TYPE_MAX;
+	shm->version = VOLUME_STATE_VERSION;
+	__sync_synchronize();
+	shm->magic = VOLUME_STATE_MAGIC;
+	return 0;
+}
+
+void _state_fini(void)
+{
+	if (shm) {
+		munmap(shm, sizeof(struct volume_state_shm));
+		shm = NULL;
+	}
+}
+
+int _state_get(int type, struct volume_state *st)
+{
+	if (shm == NULL || type < 0 || type >= (int)shm->count)
+		return -1;
+	/* generation 0: not published since the segment was set up */
+	if (shm->entry[type].st.generation == 0)
+		return -1;
+	*st = shm->entry[type].st;
+	return 0;
+}
+
+void _state_publish(int type, int level, int step, int route, int mute)
+{
+	struct volume_state_entry *e;
+
+	if (shm == NULL || type < 0 || type >= (int)shm->count)
+		return;
+
+	e = &shm->entry[type];
+	if (e->st.generation != 0 && e->st.level == level && e->st.step == step
+			&& e->st.route == route && e->st.mute == mute)
+		return;
+
+	e->seq++;
+	__sync_synchronize();
+	e->st.level = level;
+	e->st.step = step;
+	e->st.route = route;
+	e->st.mute = mute;
+	e->st.generation++;
+	__sync_synchronize();
+	e->seq++;
+	shm->generation++;
+}
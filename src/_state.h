@@ -0,0 +1,29 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_STATE_WRITER_H__
+#define __VOLUME_STATE_WRITER_H__
+
+#include "volume_state.h"
+
+int _state_init(void);
+void _state_fini(void);
+int _state_get(int type, struct volume_state *st);
+void _state_publish(int type, int level, int step, int route, int mute);
+
+#endif
+/* __VOLUME_STATE_WRITER_H__ */
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "_util_log.h"
+#include "_stats.h"
+
+/*
+ * Runtime counters and histograms, kept in a fixed layout shared memory
+ * block that any process on the device can map.
+ * _stats_export() writes them as "name value" text lines, in the format
+ * a local collector scrapes, to VOLUME_STATS_FILE or the default file.
+ * The text is written to a temporary file and renamed into place. The
+ * popup exports only when it terminates, never on the UI path; a
+ * collector wanting live numbers runs "volumectl stats", which maps
+ * the block read only.
+ */
+
+#define STATS_FILE_DEFAULT DATADIR"/.volume_stats"
+
+static struct stats_shm *shm = NULL;
+static int writer = 0;	/* _stats_init mapped it, not _stats_attach */
+
+static const char *counter_name[STATS_COUNTER_MAX] = {
+#define STATS_COUNTER(id, name) [STATS_##id] = name,
+	STATS_COUNTERS
+#undef STATS_COUNTER
+};
+
+struct hist_def {
+	const char *name;
+	unsigned int bound[STATS_BUCKET_MAX - 1];
+};
+
+static const struct hist_def hist_def[STATS_HIST_MAX] = {
+#define STATS_HIST(id, name, ...) [STATS_##id] = { name, { __VA_ARGS__ } },
+	STATS_HISTS
+#undef STATS_HIST
+};
+
+int _stats_init(void)
+{
+	int fd;
+	void *p;
+
+	if (shm)
+		return 0;
+
+	fd = shm_open(STATS_SHM_NAME, O_RDWR | O_CREAT, 0644);
+	retvm_if(fd < 0, -1, "Failed to open %s\n", STATS_SHM_NAME);
+
+	if (ftruncate(fd, sizeof(struct stats_shm)) < 0) {
+		_E("Failed to size %s\n", STATS_SHM_NAME);
+		close(fd);
+		return -1;
+	}
+
+	p = mmap(NULL, sizeof(struct stats_shm), PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0);
+	close(fd);
+	retvm_if(p == MAP_FAILED, -1, "Failed to map %s\n", STATS_SHM_NAME);
+
+	shm = p;
+	writer = 1;
+	shm->magic = 0;
+	__sync_synchronize();
+	memset((char *)shm + sizeof(shm->magic), 0,
+			sizeof(struct stats_shm) - sizeof(shm->magic));
+	shm->version = STATS_VERSION;
+	shm->pid = getpid();
+	shm->counters = STATS_COUNTER_MAX;
+	shm->hists = STATS_HIST_MAX;
+	shm->types = STATS_TYPE_MAX;
+	__sync_synchronize();
+	shm->magic = STATS_MAGIC;
+	return 0;
+}
+
+/* read only view of the block of a running popup */
+int _stats_attach(void)
+{
+	int fd;
+	void *p;
+
+	if (shm)
+		return 0;
+
+	fd = shm_open(STATS_SHM_NAME, O_RDONLY, 0);
+	retvm_if(fd < 0, -1, "Failed to open %s\n", STATS_SHM_NAME);
+	p = mmap(NULL, sizeof(struct stats_shm), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	retvm_if(p == MAP_FAILED, -1, "Failed to map %s\n", STATS_SHM_NAME);
+
+	shm = p;
+	if (shm->magic != STATS_MAGIC || shm->version != STATS_VERSION) {
+		_E("%s is not of this version\n", STATS_SHM_NAME);
+		_stats_fini();
+		return -1;
+	}
+	return 0;
+}
+
+void _stats_fini(void)
+{
+	if (shm) {
+		munmap(shm, sizeof(struct stats_shm));
+		shm = NULL;
+	}
+	writer = 0;
+}
+
+void _stats_inc(int counter)
+{
+	if (!writer || counter < 0 || counter >= STATS_COUNTER_MAX)
+		return;
+	shm->counter[counter]++;
+}
+
+void _stats_key(int type)
+{
+	if (!writer || type < 0 || type >= STATS_TYPE_MAX)
+		return;
+	shm->key_type[type]++;
+}
+
+void _stats_hist(int hist, double ms)
+{
+	int i;
+	struct stats_hist_data *h;
+
+	if (!writer || hist < 0 || hist >= STATS_HIST_MAX)
+		return;
+
+	h = &shm->hist[hist];
+	for (i = 0; i < STATS_BUCKET_MAX - 1; i++) {
+		if (ms < hist_def[hist].bound[i])
+			break;
+	}
+	h->bucket[i]++;
+	h->sum += ms;
+	h->count++;
+}
+
+void _stats_dump(FILE *fp)
+{
+	int i, j;
+	uint32_t cum;
+	const struct stats_hist_data *h;
+
+	if (shm == NULL || fp == NULL)
+		return;
+
+	for (i = 0; i < STATS_COUNTER_MAX; i++)
+		fprintf(fp, "volume_%s %u\n", counter_name[i], shm->counter[i]);
+	for (i = 0; i < STATS_TYPE_MAX; i++) {
+		if (shm->key_type[i])
+			fprintf(fp, "volume_key_type{type=\"%d\"} %u\n", i,
+					shm->key_type[i]);
+	}
+	for (i = 0; i < STATS_HIST_MAX; i++) {
+		h = &shm->hist[i];
+		cum = 0;
+		for (j = 0; j < STATS_BUCKET_MAX - 1; j++) {
+			cum += h->bucket[j];
+			fprintf(fp, "volume_%s_bucket{le=\"%u\"} %u\n",
+					hist_def[i].name, hist_def[i].bound[j], cum);
+		}
+		fprintf(fp, "volume_%s_bucket{le=\"+Inf\"} %u\n",
+				hist_def[i].name, h->count);
+		fprintf(fp, "volume_%s_sum %.3f\n", hist_def[i].name, h->sum);
+		fprintf(fp, "volume_%s_count %u\n", hist_def[i].name, h->count);
+	}
+}
+
+int _stats_export(void)
+{
+	FILE *fp;
+	const char *path = getenv("VOLUME_STATS_FILE");
+	char tmp[256];
+
+	if (shm == NULL)
+		return -1;
+	if (path == NULL)
+		path = STATS_FILE_DEFAULT;
+	snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+	fp = fopen(tmp, "w");
+	retvm_if(fp == NULL, -1, "Failed to open %s\n", tmp);
+	_stats_dump(fp);
+	if (fclose(fp) != 0 || rename(tmp, path) < 0) {
+		_E("Failed to write %s\n", path);
+		unlink(tmp);
+		return -1;
+	}
+	return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_STATS_H__
+#define __VOLUME_STATS_H__
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define STATS_SHM_NAME "/org.tizen.volume.stats"
+#define STATS_MAGIC 0x54415453	/* "STAT" */
+#define STATS_VERSION 5
+
+#define STATS_COUNTERS \
+	STATS_COUNTER(LAUNCH_COLD, "launch_cold") \
+	STATS_COUNTER(LAUNCH_WARM, "launch_warm") \
+	STATS_COUNTER(LAUNCH_REJECT, "launch_reject") \
+	STATS_COUNTER(LAUNCH_MERGED, "launch_merged") \
+	STATS_COUNTER(LAUNCH_FAIL, "launch_fail") \
+	STATS_COUNTER(LAUNCH_CANCEL, "launch_cancel") \
+	STATS_COUNTER(KEY_UP, "key_up") \
+	STATS_COUNTER(KEY_DOWN, "key_down") \
+	STATS_COUNTER(LONG_PRESS, "long_press") \
+	STATS_COUNTER(LEVEL_WRITE, "level_write") \
+	STATS_COUNTER(LEVEL_COALESCED, "level_coalesced") \
+	STATS_COUNTER(MM_NOTIFY, "mm_notify") \
+	STATS_COUNTER(VIEW_UPDATE, "view_update") \
+	STATS_COUNTER(VIEW_DORMANT, "view_dormant") \
+	STATS_COUNTER(ICON_RELOAD, "icon_reload") \
+	STATS_COUNTER(WARNING_SWAP, "warning_swap") \
+	STATS_COUNTER(STALL, "stall") \
+	STATS_COUNTER(ICON_SKIP, "icon_skip") \
+	STATS_COUNTER(TITLE_SKIP, "title_skip") \
+	STATS_COUNTER(ADMIT_LOCK_REJECT, "admit_lock_reject") \
+	STATS_COUNTER(ADMIT_CACHED_REJECT, "admit_cached_reject") \
+	STATS_COUNTER(ADMIT_PROBE_REJECT, "admit_probe_reject") \
+	STATS_COUNTER(ADMIT_POLICY_REJECT, "admit_policy_reject")
+
+/* name, bucket upper bounds in msec; the last bucket is unbounded */
+#define STATS_HISTS \
+	STATS_HIST(SHOW_MS, "show_ms", 16, 33, 50, 100, 200, 500) \
+	STATS_HIST(VISIBLE_MS, "visible_ms", 1000, 3000, 5000, 10000, 30000, 60000) \
+	STATS_HIST(LONG_PRESS_MS, "long_press_ms", 500, 1000, 2000, 3000, 5000, 10000) \
+	STATS_HIST(STALL_MS, "stall_ms", 50, 100, 200, 500, 1000, 2000) \
+	STATS_HIST(ADMIT_LOCK_MS, "admit_lock_ms", 1, 2, 5, 10, 20, 50) \
+	STATS_HIST(ADMIT_CACHED_MS, "admit_cached_ms", 1, 2, 5, 10, 20, 50) \
+	STATS_HIST(ADMIT_PROBE_MS, "admit_probe_ms", 1, 2, 5, 10, 20, 50) \
+	STATS_HIST(ADMIT_POLICY_MS, "admit_policy_ms", 1, 2, 5, 10, 20, 50)
+
+enum stats_counter {
+#define STATS_COUNTER(id, name) STATS_##id,
+	STATS_COUNTERS
+#undef STATS_COUNTER
+	STATS_COUNTER_MAX,
+};
+
+enum stats_hist {
+#define STATS_HIST(id, name, ...) STATS_##id,
+	STATS_HISTS
+#undef STATS_HIST
+	STATS_HIST_MAX,
+};
+
+#define STATS_BUCKET_MAX 7
+#define STATS_TYPE_MAX 16
+
+struct stats_hist_data {
+	uint32_t count;
+	uint32_t bucket[STATS_BUCKET_MAX];
+	double sum;	/* msec */
+};
+
+/* one writer, the main loop; readers may see a counter mid update */
+struct stats_shm {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t pid;
+	uint32_t counters;
+	uint32_t hists;
+	uint32_t types;
+	uint32_t counter[STATS_COUNTER_MAX];
+	uint32_t key_type[STATS_TYPE_MAX];	/* key presses per volume type */
+	struct stats_hist_data hist[STATS_HIST_MAX];
+};
+
+int _stats_init(void);
+int _stats_attach(void);
+void _stats_fini(void);
+void _stats_inc(int counter);
+void _stats_key(int type);
+void _stats_hist(int hist, double ms);
+void _stats_dump(FILE *fp);
+int _stats_export(void);
+
+#endif
+/* __VOLUME_STATS_H__ */
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "_util_log.h"
+#include "_trace.h"
+#include "_alloc.h"
+
+/*
+ * Launch phase tracepoints. Every launch is checked against per phase
+ * budgets and an overrun is logged as an error. When VOLUME_TRACE names
+ * a file, one tab separated line per phase is appended to it:
+ *
+ *	<epoch> <launch> <phase> <msec> <budget> <ok|over>
+ *
+ * Budgets can be overridden with VOLUME_TRACE_BUDGET="reset=80,popup=50".
+ * Phases outside the launch report are checked as soon as they end.
+ *
+ * The innermost open phase and a ring of recent begin/end marks are
+ * kept for the stall watchdog, which reads them from its own thread
+ * without locking; a torn entry only costs a line of a diagnostic.
+ */
+
+struct trace {
+	const char *name;
+	double budget;
+	double start;
+	double ms;	/* last completed run, negative if not run */
+	int launch;
+};
+
+struct trace_mark {
+	double t;
+	short phase;
+	short end;
+};
+
+static struct trace phases[TRACE_MAX] = {
+#define TRACE_PHASE(id, name, budget, launch) [TRACE_##id] = { name, budget, 0.0, -1.0, launch },
+	TRACE_PHASES
+#undef TRACE_PHASE
+};
+
+static const char *trace_file = NULL;
+
+#define TRACE_DEPTH 8
+static volatile int stack[TRACE_DEPTH];
+static volatile int depth = 0;
+
+static struct trace_mark ring[TRACE_RING_SIZE];
+static volatile unsigned int ring_head = 0;
+
+static double _now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void _set_budget(const char *name, size_t len, double budget)
+{
+	int i;
+
+	for (i = 0; i < TRACE_MAX; i++) {
+		if (strlen(phases[i].name) == len
+				&& !strncmp(phases[i].name, name, len)) {
+			phases[i].budget = budget;
+			return;
+		}
+	}
+	_E("Unknown trace phase(%.*s)\n", (int)len, name);
+}
+
+void _trace_init(void)
+{
+	const char *s, *eq;
+	char *end;
+	double budget;
+
+	trace_file = getenv("VOLUME_TRACE");
+
+	s = getenv("VOLUME_TRACE_BUDGET");
+	while (s && *s) {
+		eq = strchr(s, '=');
+		if (eq == NULL)
+			break;
+		budget = strtod(eq + 1, &end);
+		if (end != eq + 1)
+			_set_budget(s, eq - s, budget);
+		s = strchr(end, ',');
+		if (s)
+			s++;
+	}
+}
+
+static void _mark(double t, int phase, int end)
+{
+	struct trace_mark *m = &ring[ring_head % TRACE_RING_SIZE];
+	m->t = t;
+	m->phase = phase;
+	m->end = end;
+	__sync_synchronize();
+	ring_head++;
+}
+
+void _trace_begin(int phase)
+{
+	if (phase < 0 || phase >= TRACE_MAX)
+		return;
+	phases[phase].start = _now();
+	_mark(phases[phase].start, phase, 0);
+	if (depth < TRACE_DEPTH)
+		stack[depth] = phase;
+	depth++;
+	ALLOC_BEGIN(phase);
+}
+
+void _trace_end(int phase)
+{
+	double t;
+	struct trace *p;
+
+	if (phase < 0 || phase >= TRACE_MAX)
+		return;
+	ALLOC_END(phase);
+	t = _now();
+	p = &phases[phase];
+	p->ms = t - p->start;
+	_mark(t, phase, 1);
+	if (depth > 0)
+		depth--;
+
+	if (!p->launch) {
+		if (p->ms > p->budget)
+			_E("%s took %.1fms, budget %.1fms\n",
+					p->name, p->ms, p->budget);
+		p->ms = -1.0;
+	}
+}
+
+/* innermost open phase, -1 outside of any */
+int _trace_current(void)
+{
+	int d = depth;
+
+	if (d <= 0)
+		return -1;
+	if (d > TRACE_DEPTH)
+		d = TRACE_DEPTH;
+	return stack[d - 1];
+}
+
+const char *_trace_name(int phase)
+{
+	if (phase < 0 || phase >= TRACE_MAX)
+		return "none";
+	return phases[phase].name;
+}
+
+/* oldest first, returns the number of marks written */
+int _trace_snapshot(FILE *fp)
+{
+	unsigned int head = ring_head, i;
+	unsigned int n = head < TRACE_RING_SIZE ? head : TRACE_RING_SIZE;
+	struct trace_mark *m;
+
+	for (i = head - n; i != head; i++) {
+		m = &ring[i % TRACE_RING_SIZE];
+		fprintf(fp, "  %.3f %s %s\n", m->t,
+				m->end ? "end" : "begin", _trace_name(m->phase));
+	}
+	return n;
+}
+
+/* Check the phases run since the last commit, returns the overruns. */
+int _trace_commit(const char *launch)
+{
+	int i, over = 0;
+	FILE *fp = NULL;
+	time_t now;
+
+	if (trace_file) {
+		fp = fopen(trace_file, "a");
+		if (fp == NULL)
+			_E("Failed to open %s\n", trace_file);
+	}
+	now = time(NULL);
+
+	for (i = 0; i < TRACE_MAX; i++) {
+		struct trace *t = &phases[i];
+		if (t->ms < 0.0 || !t->launch)
+			continue;
+		if (t->ms > t->budget) {
+			over++;
+			_E("%s launch: %s took %.1fms, budget %.1fms\n",
+					launch, t->name, t->ms, t->budget);
+		}
+		if (fp)
+			fprintf(fp, "%ld\t%s\t%s\t%.3f\t%.1f\t%s\n", (long)now,
+					launch, t->name, t->ms, t->budget,
+					t->ms > t->budget ? "over" : "ok");
+		t->ms = -1.0;
+	}
+	if (fp)
+		fclose(fp);
+	return over;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_TRACE_H__
+#define __VOLUME_TRACE_H__
+
+#include <stdio.h>
+
+/* name, default budget in msec, part of the launch report;
+ * admit includes the join when admission has to wait on the probe */
+#define TRACE_PHASES \
+	TRACE_PHASE(CREATE, "create", 60.0, 1) \
+	TRACE_PHASE(JOIN, "join", 10.0, 1) \
+	TRACE_PHASE(ADMIT, "admit", 12.0, 1) \
+	TRACE_PHASE(SNAPSHOT, "snapshot", 16.0, 1) \
+	TRACE_PHASE(POPUP, "popup", 80.0, 1) \
+	TRACE_PHASE(SYSPOPUP, "syspopup", 20.0, 1) \
+	TRACE_PHASE(SHOW, "show", 10.0, 1) \
+	TRACE_PHASE(RESET, "reset", 120.0, 1) \
+	TRACE_PHASE(KEY, "key", 16.0, 0) \
+	TRACE_PHASE(REPEAT, "repeat", 16.0, 0) \
+	TRACE_PHASE(VIEW, "view", 16.0, 0)
+
+enum trace_phase {
+#define TRACE_PHASE(id, name, budget, launch) TRACE_##id,
+	TRACE_PHASES
+#undef TRACE_PHASE
+	TRACE_MAX,
+};
+
+#define TRACE_RING_SIZE 64
+
+void _trace_init(void);
+void _trace_begin(int phase);
+void _trace_end(int phase);
+int _trace_commit(const char *launch);
+int _trace_current(void);
+const char *_trace_name(int phase);
+int _trace_snapshot(FILE *fp);
+
+#endif
+/* __VOLUME_TRACE_H__ */
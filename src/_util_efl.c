@@ -114,3 +114,22 @@ Evas_Object *_add_label(Evas_Object *parent, const char *style, const char *text
 	return lb;
 }
 
+Evas_Object *_add_edje(Evas_Object *win, const char *file, const char *group)
+{
+	Evas_Object *eo;
+
+	retvm_if(win == NULL, NULL, "Invalid argument: window is NULL\n");
+
+	eo = edje_object_add(evas_object_evas_get(win));
+	retvm_if(eo == NULL, NULL, "Failed to add edje\n");
+
+	if (!edje_object_file_set(eo, file, group)) {
+		_E("Failed to set file[%s] group[%s]\n", file, group);
+		evas_object_del(eo);
+		return NULL;
+	}
+	evas_object_size_hint_weight_set(eo, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+	elm_win_resize_object_add(win, eo);
+	evas_object_show(eo);
+	return eo;
+}
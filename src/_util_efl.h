@@ -26,5 +26,6 @@ Evas_Object *_add_layout(Evas_Object *parent, const char *file, const char *grou
 Evas_Object *_add_button(Evas_Object *parent, const char *style, const char *text);
 Evas_Object *_add_popup(Evas_Object *parent, const char *style);
 Evas_Object *_add_label(Evas_Object *parent, const char *style, const char *text);
+Evas_Object *_add_edje(Evas_Object *win, const char *file, const char *group);
 #endif
 /* __VOLUME_UTIL_EFL_H__ */
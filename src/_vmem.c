@@ -0,0 +1,143 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "_util_log.h"
+#include "_vmem.h"
+
+/*
+ * Last used and pre-mute levels per (route, volume type).
+ * The table is a fixed layout file mapped at startup, so every update
+ * is a plain store and the kernel writes it back.
+ */
+
+#define VMEM_MAGIC 0x564d454d	/* "VMEM" */
+#define VMEM_VERSION 1
+
+struct vmem_slot {
+	unsigned char valid;
+	unsigned char level;
+	unsigned char pre_mute;
+	unsigned char reserved;
+};
+
+struct vmem_file {
+	unsigned int magic;
+	unsigned int version;
+	struct vmem_slot slot[VMEM_ROUTE_MAX][VMEM_TYPE_MAX];
+};
+
+static struct vmem_file *vmem = NULL;
+
+static struct vmem_slot *_vmem_slot(int route, int type)
+{
+	if (vmem == NULL)
+		return NULL;
+	if (route < 0 || route >= VMEM_ROUTE_MAX
+			|| type < 0 || type >= VMEM_TYPE_MAX)
+		return NULL;
+	return &vmem->slot[route][type];
+}
+
+int _vmem_init(const char *path)
+{
+	int fd;
+	void *p;
+
+	if (vmem)
+		return 0;
+
+	fd = open(path, O_RDWR | O_CREAT, 0600);
+	retvm_if(fd < 0, -1, "Failed to open %s\n", path);
+
+	if (ftruncate(fd, sizeof(struct vmem_file)) < 0) {
+		_E("Failed to size %s\n", path);
+		close(fd);
+		return -1;
+	}
+
+	p = mmap(NULL, sizeof(struct vmem_file), PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0);
+	close(fd);
+	retvm_if(p == MAP_FAILED, -1, "Failed to map %s\n", path);
+
+	vmem = p;
+	if (vmem->magic != VMEM_MAGIC || vmem->version != VMEM_VERSION) {
+		_D("reset volume memory\n");
+		memset(vmem, 0, sizeof(struct vmem_file));
+		vmem->magic = VMEM_MAGIC;
+		vmem->version = VMEM_VERSION;
+	}
+	return 0;
+}
+
+void _vmem_fini(void)
+{
+	if (vmem) {
+		munmap(vmem, sizeof(struct vmem_file));
+		vmem = NULL;
+	}
+}
+
+void _vmem_store(int route, int type, int level)
+{
+	struct vmem_slot *s = _vmem_slot(route, type);
+
+	if (s == NULL || level < 0 || level > 0xff)
+		return;
+
+	if (level == 0 && s->valid && s->level > 0)
+		s->pre_mute = s->level;
+	s->level = level;
+	s->valid = 1;
+}
+
+int _vmem_get(int route, int type, int *level)
+{
+	struct vmem_slot *s = _vmem_slot(route, type);
+
+	if (s == NULL || !s->valid)
+		return -1;
+	*level = s->level;
+	return 0;
+}
+
+/* Mute keeps the level aside, unmute brings it back. */
+int _vmem_swap_mute(int route, int type, int *level)
+{
+	unsigned char tmp;
+	struct vmem_slot *s = _vmem_slot(route, type);
+
+	if (s == NULL || !s->valid)
+		return -1;
+	if (*level > 0) {
+		s->pre_mute = *level;
+		s->level = 0;
+	} else {
+		if (s->pre_mute == 0)
+			return -1;
+		tmp = s->pre_mute;
+		s->pre_mute = 0;
+		s->level = tmp;
+	}
+	*level = s->level;
+	return 0;
+}
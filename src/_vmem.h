@@ -0,0 +1,31 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_VMEM_H__
+#define __VOLUME_VMEM_H__
+
+#define VMEM_ROUTE_MAX 8
+#define VMEM_TYPE_MAX 16
+
+int _vmem_init(const char *path);
+void _vmem_fini(void);
+void _vmem_store(int route, int type, int level);
+int _vmem_get(int route, int type, int *level);
+int _vmem_swap_mute(int route, int type, int *level);
+
+#endif
+/* __VOLUME_VMEM_H__ */
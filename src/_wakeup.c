@@ -0,0 +1,218 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "volume.h"
+#include "_util_log.h"
+#include "_wakeup.h"
+
+/*
+ * Wakeup accounting, built with WAKEUP_ACCOUNTING only. Timers added
+ * with ADD_TIMER carry their callback name, and fd, event and vconf
+ * handlers mark themselves with WAKEUP_BEGIN/WAKEUP_END. The first
+ * source to run after the main loop leaves idle owns that wakeup;
+ * every source also gets its call count and thread CPU time. Wakeups
+ * no source claimed are booked as "other" (rendering, animators,
+ * handlers of other libraries). Wakeups and wall time are split by
+ * hidden, visible and long press state to give wakeups per second.
+ */
+
+#if defined(WAKEUP_ACCOUNTING)
+
+#define WAKEUP_SOURCE_MAX 32
+
+struct wakeup_source {
+	const char *name;
+	unsigned int wakeups;
+	unsigned int calls;
+	double cpu;	/* msec of main thread CPU time */
+};
+
+struct wakeup_timer {
+	const char *name;
+	Ecore_Task_Cb cb;
+	const void *data;
+	int running;
+	int deleted;
+};
+
+static struct wakeup_source sources[WAKEUP_SOURCE_MAX];
+static int nsources;
+static int unclaimed;	/* the loop woke up and no source ran yet */
+static unsigned int other;
+
+static int state = WAKEUP_HIDDEN;
+static double state_since;
+static unsigned int state_wakeups[WAKEUP_STATE_MAX];
+static double state_time[WAKEUP_STATE_MAX];	/* msec */
+
+static const char *state_name[WAKEUP_STATE_MAX] = {
+	"hidden", "visible", "long press",
+};
+
+static double _clock(clockid_t id)
+{
+	struct timespec ts;
+	clock_gettime(id, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static Eina_Bool _exit_idle_cb(void *data)
+{
+	if (unclaimed)
+		other++;
+	unclaimed = 1;
+	state_wakeups[state]++;
+	return ECORE_CALLBACK_RENEW;
+}
+
+int _wakeup_init(void)
+{
+	state_since = _clock(CLOCK_MONOTONIC);
+	retvm_if(ecore_idle_exiter_add(_exit_idle_cb, NULL) == NULL, -1,
+			"Failed to add idle exiter\n");
+	return 0;
+}
+
+/* sources are string literals, so the pointer is checked first */
+static int _lookup(const char *name)
+{
+	int i;
+
+	for (i = 0; i < nsources; i++) {
+		if (sources[i].name == name || !strcmp(sources[i].name, name))
+			return i;
+	}
+	if (nsources == WAKEUP_SOURCE_MAX)
+		return -1;
+	sources[nsources].name = name;
+	return nsources++;
+}
+
+int _wakeup_begin(const char *source)
+{
+	int id = _lookup(source);
+
+	if (id < 0)
+		return -1;
+	if (unclaimed) {
+		sources[id].wakeups++;
+		unclaimed = 0;
+	}
+	sources[id].calls++;
+	sources[id].cpu -= _clock(CLOCK_THREAD_CPUTIME_ID);
+	return id;
+}
+
+void _wakeup_end(int id)
+{
+	if (id < 0)
+		return;
+	sources[id].cpu += _clock(CLOCK_THREAD_CPUTIME_ID);
+}
+
+void _wakeup_state(int next)
+{
+	double now;
+
+	if (next < 0 || next >= WAKEUP_STATE_MAX || next == state)
+		return;
+	now = _clock(CLOCK_MONOTONIC);
+	state_time[state] += now - state_since;
+	state_since = now;
+	state = next;
+}
+
+static Eina_Bool _timer_cb(void *data)
+{
+	int id;
+	Eina_Bool ret;
+	struct wakeup_timer *wt = (struct wakeup_timer *)data;
+
+	id = _wakeup_begin(wt->name);
+	wt->running = 1;
+	ret = wt->cb((void *)wt->data);
+	wt->running = 0;
+	_wakeup_end(id);
+
+	if (ret == ECORE_CALLBACK_CANCEL || wt->deleted) {
+		free(wt);
+		return ECORE_CALLBACK_CANCEL;
+	}
+	return ret;
+}
+
+Ecore_Timer *_wakeup_timer_add(const char *name, double time,
+		Ecore_Task_Cb cb, const void *data)
+{
+	Ecore_Timer *timer;
+	struct wakeup_timer *wt;
+
+	wt = calloc(1, sizeof(struct wakeup_timer));
+	retvm_if(wt == NULL, NULL, "Failed to allocate timer\n");
+	wt->name = name;
+	wt->cb = cb;
+	wt->data = data;
+
+	timer = TIMER_ADD(time, _timer_cb, wt);
+	if (timer == NULL)
+		free(wt);
+	return timer;
+}
+
+/* a timer may delete itself from its own callback */
+void *_wakeup_timer_del(Ecore_Timer *timer)
+{
+	const void *data;
+	struct wakeup_timer *wt = TIMER_DEL(timer);
+
+	if (wt == NULL)
+		return NULL;
+	data = wt->data;
+	if (wt->running)
+		wt->deleted = 1;
+	else
+		free(wt);
+	return (void *)data;
+}
+
+void _wakeup_dump(void)
+{
+	int i;
+	double now = _clock(CLOCK_MONOTONIC);
+
+	state_time[state] += now - state_since;
+	state_since = now;
+
+	for (i = 0; i < WAKEUP_STATE_MAX; i++) {
+		if (state_time[i] <= 0.0)
+			continue;
+		_D("wakeups %s(%u) in %.1fs, %.2f/s\n", state_name[i],
+				state_wakeups[i], state_time[i] / 1000.0,
+				state_wakeups[i] * 1000.0 / state_time[i]);
+	}
+	for (i = 0; i < nsources; i++) {
+		_D("  %s wakeups(%u) calls(%u) cpu(%.3fms)\n", sources[i].name,
+				sources[i].wakeups, sources[i].calls, sources[i].cpu);
+	}
+	_D("  other wakeups(%u)\n", other);
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_WAKEUP_H__
+#define __VOLUME_WAKEUP_H__
+
+#include <Ecore.h>
+
+enum wakeup_state {
+	WAKEUP_HIDDEN = 0,
+	WAKEUP_VISIBLE,
+	WAKEUP_LONG_PRESS,
+	WAKEUP_STATE_MAX,
+};
+
+#if defined(WAKEUP_ACCOUNTING)
+int _wakeup_init(void);
+int _wakeup_begin(const char *source);
+void _wakeup_end(int id);
+void _wakeup_state(int state);
+void _wakeup_dump(void);
+Ecore_Timer *_wakeup_timer_add(const char *name, double time,
+		Ecore_Task_Cb cb, const void *data);
+void *_wakeup_timer_del(Ecore_Timer *timer);
+
+#  define WAKEUP_INIT()		_wakeup_init()
+#  define WAKEUP_BEGIN(source)	int _wakeup_id = _wakeup_begin(source)
+#  define WAKEUP_END()		_wakeup_end(_wakeup_id)
+#  define WAKEUP_STATE(state)	_wakeup_state(state)
+#  define WAKEUP_DUMP()		_wakeup_dump()
+#else
+#  define WAKEUP_INIT()
+#  define WAKEUP_BEGIN(source)
+#  define WAKEUP_END()
+#  define WAKEUP_STATE(state)
+#  define WAKEUP_DUMP()
+#endif
+
+#endif
+/* __VOLUME_WAKEUP_H__ */
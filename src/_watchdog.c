@@ -0,0 +1,222 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <Ecore.h>
+
+#include "_util_log.h"
+#include "_trace.h"
+#include "_watchdog.h"
+#include "_stats.h"
+
+/*
+ * Main loop stall watchdog, off unless VOLUME_STALL_MS sets the
+ * threshold. The idle exiter marks the start of every main loop
+ * iteration and the idle enterer its end. A worker thread sleeps on a
+ * condition while the main loop is idle, so a hidden popup costs no
+ * wakeups; during an iteration it polls at half the threshold, and when
+ * the iteration has been running for longer than the threshold it
+ * writes the open trace phase and the recent trace marks to the stall
+ * file, once per stall, while the main loop is still stuck. The main
+ * loop files the final duration into the stall histogram of _stats.c
+ * when the iteration ends.
+ *
+ * VOLUME_STALL_FILE sets the file. It is moved to <file>.1 once it
+ * grows past STALL_FILE_MAX, so at most two of them are kept.
+ */
+
+#define STALL_FILE_DEFAULT DATADIR"/.volume_stall"
+#define STALL_FILE_MAX (64 * 1024)
+
+struct watchdog {
+	pthread_t tid;
+	pthread_mutex_t lock;
+	pthread_cond_t busy;	/* signalled when an iteration starts */
+	volatile int running;
+	unsigned int threshold;
+	const char *file;
+
+	/* written by the main loop, read by the worker */
+	volatile uint64_t busy_since;	/* usec, 0 while idle */
+	volatile unsigned int iteration;
+	unsigned int reported;	/* worker only */
+
+	/* main loop only */
+	struct stall_stats st;
+	Ecore_Idle_Enterer *enterer;
+	Ecore_Idle_Exiter *exiter;
+};
+
+static struct watchdog wd = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.busy = PTHREAD_COND_INITIALIZER,
+};
+
+static uint64_t _now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static Eina_Bool _busy_cb(void *data)
+{
+	wd.iteration++;
+	__sync_lock_test_and_set(&wd.busy_since, _now_us());
+	pthread_mutex_lock(&wd.lock);
+	pthread_cond_signal(&wd.busy);
+	pthread_mutex_unlock(&wd.lock);
+	return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool _idle_cb(void *data)
+{
+	uint64_t since = __sync_lock_test_and_set(&wd.busy_since, 0);
+	double ms;
+
+	if (since == 0)
+		return ECORE_CALLBACK_RENEW;
+	ms = (_now_us() - since) / 1000.0;
+	if (ms < wd.threshold)
+		return ECORE_CALLBACK_RENEW;
+
+	wd.st.count++;
+	if (ms > wd.st.worst)
+		wd.st.worst = ms;
+	_stats_inc(STATS_STALL);
+	_stats_hist(STATS_STALL_MS, ms);
+	_E("main loop stalled %.1fms\n", ms);
+	return ECORE_CALLBACK_RENEW;
+}
+
+static void _rotate(void)
+{
+	struct stat st;
+	char old[256];
+
+	if (stat(wd.file, &st) < 0 || st.st_size < STALL_FILE_MAX)
+		return;
+	snprintf(old, sizeof(old), "%s.1", wd.file);
+	if (rename(wd.file, old) < 0)
+		_E("Failed to rotate %s\n", wd.file);
+}
+
+static void _snapshot(double ms)
+{
+	FILE *fp;
+	int phase = _trace_current();
+
+	_rotate();
+	fp = fopen(wd.file, "a");
+	retm_if(fp == NULL, "Failed to open %s\n", wd.file);
+	fprintf(fp, "stall %ld over %.1fms in %s\n", (long)time(NULL), ms,
+			_trace_name(phase));
+	_trace_snapshot(fp);
+	fclose(fp);
+	wd.st.snapshots++;
+}
+
+static void *_watchdog_thread(void *data)
+{
+	uint64_t since;
+	unsigned int it;
+	double ms;
+
+	while (wd.running) {
+		pthread_mutex_lock(&wd.lock);
+		while (wd.running && __sync_fetch_and_add(&wd.busy_since, 0) == 0)
+			pthread_cond_wait(&wd.busy, &wd.lock);
+		pthread_mutex_unlock(&wd.lock);
+		if (!wd.running)
+			break;
+
+		usleep(wd.threshold * 1000 / 2);
+		since = __sync_fetch_and_add(&wd.busy_since, 0);
+		if (since == 0)
+			continue;
+		it = wd.iteration;
+		ms = (_now_us() - since) / 1000.0;
+		if (ms >= wd.threshold && it != wd.reported) {
+			wd.reported = it;
+			_snapshot(ms);
+		}
+	}
+	return NULL;
+}
+
+int _watchdog_start(void)
+{
+	const char *s;
+
+	if (wd.running)
+		return 0;
+
+	s = getenv("VOLUME_STALL_MS");
+	if (s == NULL)
+		return 0;
+	wd.threshold = atoi(s);
+	retvm_if(wd.threshold == 0, -1, "Invalid stall threshold(%s)\n", s);
+	s = getenv("VOLUME_STALL_FILE");
+	wd.file = s ? s : STALL_FILE_DEFAULT;
+	wd.st.threshold = wd.threshold;
+
+	wd.exiter = ecore_idle_exiter_add(_busy_cb, NULL);
+	wd.enterer = ecore_idle_enterer_add(_idle_cb, NULL);
+	retvm_if(wd.exiter == NULL || wd.enterer == NULL, -1,
+			"Failed to add idle handlers\n");
+
+	wd.running = 1;
+	if (pthread_create(&wd.tid, NULL, _watchdog_thread, NULL) != 0) {
+		_E("Failed to start watchdog thread\n");
+		wd.running = 0;
+		return -1;
+	}
+	return 0;
+}
+
+void _watchdog_stop(void)
+{
+	if (!wd.running)
+		return;
+	pthread_mutex_lock(&wd.lock);
+	wd.running = 0;
+	pthread_cond_signal(&wd.busy);
+	pthread_mutex_unlock(&wd.lock);
+	pthread_join(wd.tid, NULL);
+}
+
+void _watchdog_get(struct stall_stats *st)
+{
+	if (st)
+		*st = wd.st;
+}
+
+void _watchdog_dump(void)
+{
+	if (wd.st.count == 0)
+		return;
+	_D("stalls over %ums(%u) worst(%.1fms) snapshots(%u)\n", wd.threshold,
+			wd.st.count, wd.st.worst, wd.st.snapshots);
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_WATCHDOG_H__
+#define __VOLUME_WATCHDOG_H__
+
+struct stall_stats {
+	unsigned int threshold;	/* msec */
+	unsigned int count;
+	unsigned int snapshots;
+	double worst;	/* msec */
+};
+
+int _watchdog_start(void);
+void _watchdog_stop(void);
+void _watchdog_get(struct stall_stats *st);
+void _watchdog_dump(void);
+
+#endif
+/* __VOLUME_WATCHDOG_H__ */
@@ -21,6 +21,16 @@
 #include "_util_log.h"
 #include "_util_efl.h"
 #include "_logic.h"
+#include "_state.h"
+#include "_vmem.h"
+#include "_startup.h"
+#include "_catalog.h"
+#include "_trace.h"
+#include "_record.h"
+#include "_watchdog.h"
+#include "_stats.h"
+#include "_backend.h"
+#include "_alloc.h"
 
 struct text_part {
 	char *part;
@@ -38,9 +48,13 @@ static int app_create(void *data)
 
 	retvm_if(ad == NULL, -1, "Invalid argument: appdata is NULL\n");
 
+	_trace_init();
+	_backend_init(NULL);
+	_trace_begin(TRACE_CREATE);
 	_app_create(ad);
 
 	lang_changed(ad);
+	_trace_end(TRACE_CREATE);
 
 	/* add system event callback */
 	appcore_set_event_callback(APPCORE_EVENT_LANG_CHANGE,
@@ -61,6 +75,16 @@ static int app_terminate(void *data)
 	if (ad->win)
 		evas_object_del(ad->win);
 
+	/* a rejected first launch leaves the probe running */
+	_startup_probe_join(ad);
+	_state_fini();
+	_vmem_fini();
+	_catalog_fini();
+	_record_fini();
+	_watchdog_stop();
+	_stats_export();
+	_stats_fini();
+
 	return 0;
 }
 
@@ -115,8 +139,11 @@ int main(int argc, char *argv[])
 	printf("from AUL to %s(): %d msec\n", __func__,
 			appcore_measure_time_from("APP_START_TIME"));
 
+	ALLOC_INIT();
 	memset(&ad, 0x0, sizeof(struct appdata));
 	ops.data = &ad;
+	/* replayed launches take the same path as the ones of appcore */
+	_app_set_reset(app_reset);
 
 	return appcore_efl_main(PACKAGE, &argc, &argv, &ops);
 }
@@ -46,38 +46,69 @@
 #define EDJ_THEME EDJDIR"/volume_popup.edj"
 #define GRP_VOLUME_SLIDER "popup_slider_style"
 #define GRP_VOLUME_SLIDER_WITH_WARNING "popup_slider_text_style_with_warn_label"
+#define GRP_VOLUME_FLAT "volume_flat_popup"
 
 #define S_(str) dgettext("sys_string", str)
 #define T_(str) dgettext(PACKAGE, str)
 
-#define ADD_TIMER(x, time, _timer_cb, data) \
-	x = ecore_timer_add(time, _timer_cb, data);\
+/* Every popup timer goes through these, so a build can substitute
+ * its own clock with -DTIMER_ADD=... -DTIMER_DEL=... */
+#if !defined(TIMER_ADD)
+#  define TIMER_ADD ecore_timer_add
+#endif
+#if !defined(TIMER_DEL)
+#  define TIMER_DEL ecore_timer_del
+#endif
+
+/* The accounting build books every timer wakeup under its callback.
+ * Its wrappers add and delete through TIMER_ADD and TIMER_DEL, so the
+ * two hooks stack. */
+#if defined(WAKEUP_ACCOUNTING)
+#  include "_wakeup.h"
+#  define ADD_TIMER(x, time, _timer_cb, data) \
+	x = _wakeup_timer_add(#_timer_cb, time, _timer_cb, data);\
 
-#define DEL_TIMER(x) \
+#  define DEL_TIMER(x) \
 	if (x) {\
-		ecore_timer_del(x);\
+		_wakeup_timer_del(x);\
 		x = NULL;\
 	}
+#else
+#  define ADD_TIMER(x, time, _timer_cb, data) \
+	x = TIMER_ADD(time, _timer_cb, data);\
+
+#  define DEL_TIMER(x) \
+	if (x) {\
+		TIMER_DEL(x);\
+		x = NULL;\
+	}
+#endif
 
 struct appdata
 {
 	Evas_Object *win, *pu, *bt, *sl, *ic, *warn_lb, *warn_ly;
+	Evas_Object *fl;	/* single edje popup, FLAT_POPUP only */
 
 	Ecore_Timer *ptimer;
 	Ecore_Timer *stimer;	/* slider timer */
 	Ecore_Timer *sutimer, *sdtimer, *lutimer, *ldtimer;	/* long press */
 	Ecore_Timer *warntimer;	/* warning message timer */
+	Ecore_Timer *rtimer;	/* waits for the route to follow the earjack */
 	volume_type_t type;
 	int step;
-	int before_mute[32];
+	int route;	/* last known playback device */
 
 	/* ug handler */
 	ui_gadget_h ug;
 
+	/* X resources looked up once when the window is created */
+	Ecore_X_Window xwin;
+	Ecore_X_Display *disp;
+	Ecore_Event_Handler *key_down, *key_up;
+	int flag_grabbed;
+
 	/* add more variables here */
-	int sh;	/* svi handle */
-	int flag_pressing;	/* to set hard key press */
-	int flag_touching;
+	int input_mode;	/* owned by _input.c */
 	int flag_launching;	/* to block double launching by double click */
 	int flag_deleting;
 	int flag_warning;	/* set device warning flag */
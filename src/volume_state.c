@@ -0,0 +1,107 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "volume_state.h"
+
+#define READ_RETRY_MAX 64
+
+static const struct volume_state_shm *shm = NULL;
+
+int volume_state_attach(void)
+{
+	struct stat st;
+	int fd;
+	void *p;
+
+	if (shm)
+		return 0;
+
+	fd = shm_open(VOLUME_STATE_SHM_NAME, O_RDONLY, 0);
+	if (fd < 0)
+		return -errno;
+
+	/* the writer may not have sized the segment yet */
+	if (fstat(fd, &st) < 0) {
+		close(fd);
+		return -errno;
+	}
+	if (st.st_size < (off_t)sizeof(struct volume_state_shm)) {
+		close(fd);
+		return -EPROTO;
+	}
+
+	p = mmap(NULL, sizeof(struct volume_state_shm), PROT_READ,
+			MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED)
+		return -errno;
+
+	shm = p;
+	if (shm->magic != VOLUME_STATE_MAGIC
+			|| shm->version != VOLUME_STATE_VERSION) {
+		volume_state_detach();
+		return -EPROTO;
+	}
+	return 0;
+}
+
+void volume_state_detach(void)
+{
+	if (shm) {
+		munmap((void *)shm, sizeof(struct volume_state_shm));
+		shm = NULL;
+	}
+}
+
+unsigned int volume_state_generation(void)
+{
+	if (shm == NULL)
+		return 0;
+	return shm->generation;
+}
+
+int volume_state_read(int type, struct volume_state *st)
+{
+	const struct volume_state_entry *e;
+	unsigned int seq;
+	int i;
+
+	if (shm == NULL || st == NULL)
+		return -EINVAL;
+	if (type < 0 || type >= (int)shm->count)
+		return -EINVAL;
+
+	e = &shm->entry[type];
+	for (i = 0; i < READ_RETRY_MAX; i++) {
+		seq = e->seq;
+		if (seq & 1)
+			continue;
+		__sync_synchronize();
+		*st = e->st;
+		__sync_synchronize();
+		if (e->seq == seq)
+			return 0;
+	}
+	/* writer is stuck in the middle of an update */
+	return -EAGAIN;
+}
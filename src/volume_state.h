@@ -0,0 +1,66 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __VOLUME_STATE_H__
+#define __VOLUME_STATE_H__
+
+/*
+ * Volume state published by org.tizen.volume for other system components.
+ *
+ * The popup keeps one entry per volume_type_t in a POSIX shared memory
+ * segment. Each entry is guarded by its own sequence counter: the writer
+ * makes it odd before touching the entry and even again afterwards, so a
+ * reader only has to retry when it observes an odd or changed counter.
+ * After volume_state_attach(), reading a snapshot needs no lock and no
+ * system call.
+ */
+
+#ifndef VOLUME_STATE_SHM_NAME
+#define VOLUME_STATE_SHM_NAME	"/org.tizen.volume.state"
+#endif
+#define VOLUME_STATE_MAGIC	0x564f4c53	/* "VOLS" */
+#define VOLUME_STATE_VERSION	1
+#define VOLUME_STATE_TYPE_MAX	16
+
+struct volume_state {
+	int level;
+	int step;			/* max level */
+	int route;			/* system_audio_route_device_t */
+	int mute;
+	unsigned int generation;	/* bumped on every update of this type */
+};
+
+struct volume_state_entry {
+	volatile unsigned int seq;
+	struct volume_state st;
+};
+
+struct volume_state_shm {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int count;		/* number of valid entries */
+	volatile unsigned int generation;	/* bumped on any update */
+	struct volume_state_entry entry[VOLUME_STATE_TYPE_MAX];
+};
+
+int volume_state_attach(void);
+void volume_state_detach(void);
+unsigned int volume_state_generation(void);
+int volume_state_read(int type, struct volume_state *st);
+
+#endif
+/* __VOLUME_STATE_H__ */
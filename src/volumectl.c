@@ -0,0 +1,329 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * volumectl: query and set stream levels without the popup.
+ *
+ * usage: volumectl [-b mm|sim] <command> [args]
+ *
+ * Types are names ("media") or volume_type_t numbers. "batch" reads
+ * the other commands from stdin, one per line, '#' starts a comment.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <mm_sound.h>
+
+#include "_backend.h"
+#include "_level.h"
+#include "_stats.h"
+
+#define LINE_MAX_LEN 256
+#define ARGS_MAX 8
+#define BENCH_COUNT 1000
+
+struct name {
+	const char *name;
+	int value;
+};
+
+static const struct name types[] = {
+	{ "system", VOLUME_TYPE_SYSTEM },
+	{ "notification", VOLUME_TYPE_NOTIFICATION },
+	{ "alarm", VOLUME_TYPE_ALARM },
+	{ "ringtone", VOLUME_TYPE_RINGTONE },
+	{ "media", VOLUME_TYPE_MEDIA },
+	{ "call", VOLUME_TYPE_CALL },
+	{ "java", VOLUME_TYPE_EXT_JAVA },
+	{ "android", VOLUME_TYPE_EXT_ANDROID },
+	{ NULL, 0 },
+};
+
+static const char *type_name(int type)
+{
+	const struct name *t;
+
+	for (t = types; t->name; t++) {
+		if (t->value == type)
+			return t->name;
+	}
+	return "unknown";
+}
+
+static int parse_type(const char *s)
+{
+	const struct name *t;
+	char *end;
+	long v;
+
+	for (t = types; t->name; t++) {
+		if (!strcmp(t->name, s))
+			return t->value;
+	}
+	v = strtol(s, &end, 10);
+	if (*s == '\0' || *end != '\0' || v < 0 || v >= VOLUME_TYPE_MAX) {
+		fprintf(stderr, "unknown type \"%s\"\n", s);
+		return -1;
+	}
+	return (int)v;
+}
+
+static int cmd_get(int type)
+{
+	int val;
+
+	if (_level_read(type, &val) < 0)
+		return 1;
+	printf("%d\n", val);
+	return 0;
+}
+
+static int cmd_set(int type, const char *s)
+{
+	int max, val, cur;
+	char *end;
+
+	val = (int)strtol(s, &end, 10);
+	max = _level_max(type);
+	if (*s == '\0' || *end != '\0' || val < 0 || (max > 0 && val > max)) {
+		fprintf(stderr, "bad level \"%s\" for %s (0-%d)\n",
+				s, type_name(type), max);
+		return 1;
+	}
+	/* start from the server's level, another client may have moved it */
+	if (_level_read(type, &cur) < 0)
+		return 1;
+	return _level_set(type, val) < 0;
+}
+
+static int cmd_dump(void)
+{
+	int type, val;
+
+	printf("{\n\t\"backend\": \"%s\",\n\t\"route\": %d,\n\t\"types\": {\n",
+			_backend_name(), _backend_get_route());
+	for (type = 0; type < VOLUME_TYPE_MAX; type++) {
+		if (_level_read(type, &val) < 0)
+			val = -1;
+		printf("\t\t\"%s\": { \"type\": %d, \"level\": %d, \"max\": %d }%s\n",
+				type_name(type), type, val, _level_max(type),
+				type + 1 < VOLUME_TYPE_MAX ? "," : "");
+	}
+	printf("\t}\n}\n");
+	return 0;
+}
+
+/* counters of the running popup, printed or written to its stats file */
+static int cmd_stats(int export)
+{
+	int rc = 0;
+
+	if (_stats_attach() < 0)
+		return 1;
+	if (!export)
+		_stats_dump(stdout);
+	else if (_stats_export() < 0)
+		rc = 1;
+	_stats_fini();
+	return rc;
+}
+
+/* bench: latency of every backend call the popup makes on a key press */
+
+enum {
+	BENCH_GET = 0,
+	BENCH_SET,
+	BENCH_STEP,
+	BENCH_ROUTE,
+	BENCH_MAX,
+};
+
+static const char *bench_name[BENCH_MAX] = {
+	"get", "set", "step", "route",
+};
+
+static double now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return x < y ? -1 : x > y;
+}
+
+static double bench_call(int op, int type, int i, int base)
+{
+	double t;
+	int v;
+
+	t = now_us();
+	switch (op) {
+	case BENCH_GET:
+		_backend_get_level(type, &v);
+		break;
+	case BENCH_SET:
+		/* toggle so every call reaches the server */
+		_backend_set_level(type, base ^ (i & 1));
+		break;
+	case BENCH_STEP:
+		_backend_get_step(type, &v);
+		break;
+	case BENCH_ROUTE:
+		_backend_get_route();
+		break;
+	}
+	return now_us() - t;
+}
+
+static int cmd_bench(int type, int count)
+{
+	double *lat;
+	int op, i, base;
+
+	if (count <= 0) {
+		fprintf(stderr, "bad count %d\n", count);
+		return 1;
+	}
+	lat = malloc(count * sizeof(double));
+	if (lat == NULL)
+		return 1;
+	if (_backend_get_level(type, &base) < 0) {
+		free(lat);
+		return 1;
+	}
+
+	printf("# backend(%s) type(%s) count(%d), usec\n",
+			_backend_name(), type_name(type), count);
+	printf("call\tmin\tp50\tp90\tp99\tmax\n");
+	for (op = 0; op < BENCH_MAX; op++) {
+		for (i = 0; i < count; i++)
+			lat[i] = bench_call(op, type, i, base);
+		qsort(lat, count, sizeof(double), cmp_double);
+		printf("%s\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\n", bench_name[op],
+				lat[0], lat[count / 2], lat[count * 9 / 10],
+				lat[count * 99 / 100], lat[count - 1]);
+	}
+	_backend_set_level(type, base);
+
+	free(lat);
+	return 0;
+}
+
+static int run(int argc, char *argv[]);
+
+static int cmd_batch(void)
+{
+	char line[LINE_MAX_LEN], *args[ARGS_MAX], *p;
+	unsigned int lineno = 0;
+	int n, rc = 0;
+
+	while (fgets(line, sizeof(line), stdin)) {
+		lineno++;
+		p = strchr(line, '#');
+		if (p)
+			*p = '\0';
+		n = 0;
+		for (p = strtok(line, " \t\n"); p && n < ARGS_MAX;
+				p = strtok(NULL, " \t\n"))
+			args[n++] = p;
+		if (n == 0)
+			continue;
+		if (!strcmp(args[0], "batch") || run(n, args) != 0) {
+			fprintf(stderr, "stdin:%u: \"%s\" failed\n", lineno, args[0]);
+			rc = 1;
+		}
+	}
+	return rc;
+}
+
+static int usage(void)
+{
+	fprintf(stderr,
+		"usage: volumectl [-b mm|sim] <command> [args]\n"
+		"  get <type>           print the level\n"
+		"  set <type> <level>   write the level\n"
+		"  step <type>          print the highest level\n"
+		"  route                print the playing route\n"
+		"  dump                 print every level as JSON\n"
+		"  stats [export]       print the popup counters, or write its stats file\n"
+		"  batch                run commands from stdin\n"
+		"  bench [type] [count] backend call latency\n");
+	return 1;
+}
+
+static int run(int argc, char *argv[])
+{
+	int type = VOLUME_TYPE_MEDIA;
+
+	if (argc >= 2 && strcmp(argv[0], "bench") && strcmp(argv[0], "stats")) {
+		type = parse_type(argv[1]);
+		if (type < 0)
+			return 1;
+	}
+
+	if (!strcmp(argv[0], "get") && argc == 2)
+		return cmd_get(type);
+	if (!strcmp(argv[0], "set") && argc == 3)
+		return cmd_set(type, argv[2]);
+	if (!strcmp(argv[0], "step") && argc == 2) {
+		printf("%d\n", _level_max(type));
+		return 0;
+	}
+	if (!strcmp(argv[0], "route") && argc == 1) {
+		printf("%d\n", _backend_get_route());
+		return 0;
+	}
+	if (!strcmp(argv[0], "dump") && argc == 1)
+		return cmd_dump();
+	if (!strcmp(argv[0], "stats") && argc == 1)
+		return cmd_stats(0);
+	if (!strcmp(argv[0], "stats") && argc == 2 && !strcmp(argv[1], "export"))
+		return cmd_stats(1);
+	if (!strcmp(argv[0], "batch") && argc == 1)
+		return cmd_batch();
+	if (!strcmp(argv[0], "bench") && argc <= 3) {
+		if (argc >= 2 && (type = parse_type(argv[1])) < 0)
+			return 1;
+		return cmd_bench(type, argc == 3 ? atoi(argv[2]) : BENCH_COUNT);
+	}
+	return usage();
+}
+
+int main(int argc, char *argv[])
+{
+	const char *backend = NULL;
+
+	argc--;
+	argv++;
+	if (argc >= 2 && !strcmp(argv[0], "-b")) {
+		backend = argv[1];
+		argc -= 2;
+		argv += 2;
+	}
+	if (argc < 1)
+		return usage();
+	if (_backend_init(backend) < 0)
+		return 1;
+
+	return run(argc, argv);
+}
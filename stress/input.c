@@ -0,0 +1,396 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/*
+ * Virtual clock stress of the popup input logic.
+ *
+ * Random key, long press, slider, ug, launch, close, mute and sound
+ * server events are fed to the popup timers and input handlers of
+ * src/_control.c, through the input arbitration of src/_input.c and the
+ * level core on the "sim" backend. Every timer goes through the
+ * TIMER_ADD/TIMER_DEL hook to the virtual clock in vclock.c, so hours
+ * of key repeat and popup timeouts run in seconds. The view calls of
+ * the handlers are stubbed below.
+ *
+ * After every event:
+ *  - each level is within [0, max] and the cache matches the backend
+ *  - every live timer is owned by exactly one appdata field, and every
+ *    field set is a live timer
+ *  - a hidden popup is idle and owns no timers, the slider timer runs
+ *    only while touching
+ *  - the popup writes at most once per input or timer callback in any
+ *    virtual second
+ *
+ *  volume-input-stress [events] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "volume.h"
+#include "_input.h"
+#include "_control.h"
+#include "_backend.h"
+#include "_level.h"
+#include "_notify.h"
+#include "vclock.h"
+
+#define EVENT_DEFAULT 2000000
+
+enum {
+	EV_KEY_DOWN,
+	EV_KEY_UP,
+	EV_TOUCH_START,
+	EV_TOUCH_MOVE,
+	EV_TOUCH_STOP,
+	EV_LAUNCH,
+	EV_CLICK,
+	EV_UG_OPEN,
+	EV_UG_CLOSE,
+	EV_NOTIFY,
+	EV_MUTE,
+	EV_MAX,
+};
+
+/* relative frequency of each event */
+static const int weight[EV_MAX] = {
+	[EV_KEY_DOWN] = 20,
+	[EV_KEY_UP] = 20,
+	[EV_TOUCH_START] = 6,
+	[EV_TOUCH_MOVE] = 14,
+	[EV_TOUCH_STOP] = 6,
+	[EV_LAUNCH] = 8,
+	[EV_CLICK] = 2,
+	[EV_UG_OPEN] = 1,
+	[EV_UG_CLOSE] = 1,
+	[EV_NOTIFY] = 10,
+	[EV_MUTE] = 1,
+};
+
+static const int launch_types[] = {
+	VOLUME_TYPE_RINGTONE, VOLUME_TYPE_MEDIA, VOLUME_TYPE_NOTIFICATION,
+	VOLUME_TYPE_ALARM, VOLUME_TYPE_CALL,
+};
+
+static struct appdata ad;
+static struct notify_queue queue;
+static int visible;
+static int slider;	/* where the finger holds the knob */
+static int sound = 1;	/* sound status setting */
+static int external;	/* a write by another client is in progress */
+
+static uint64_t rnd_state;
+static unsigned long seed;
+static unsigned long events, inputs, writes;
+static double window;	/* start of the virtual second being counted */
+static unsigned long window_writes, window_budget, window_fired;
+
+static uint32_t _rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 7;
+	rnd_state ^= rnd_state << 17;
+	return (uint32_t)(rnd_state >> 16);
+}
+
+static int _pick(const int *w, int n)
+{
+	int i, sum = 0, r;
+
+	for (i = 0; i < n; i++)
+		sum += w[i];
+	r = _rnd() % sum;
+	for (i = 0; r >= w[i]; i++)
+		r -= w[i];
+	return i;
+}
+
+static void _fail(const char *what)
+{
+	fprintf(stderr, "FAIL seed %lu event %lu at %.3fs: %s\n",
+			seed, events, _vclock_now(), what);
+	exit(1);
+}
+
+/* the sound server reports every level change, ours included */
+static void _changed(void *data)
+{
+	int type = (int)(intptr_t)data;
+
+	if (!external) {
+		writes++;
+		window_writes++;
+	}
+	_notify_push(&queue, type);
+}
+
+static void _drain(void)
+{
+	int type, val;
+
+	_notify_rearm(&queue);
+	while (_notify_pop(&queue, &type) == 0)
+		_level_read(type, &val);
+}
+
+/* the view, as src/_control.c sees it */
+
+int _close_volume(void *data)
+{
+	_control_hide(&ad);
+	visible = 0;
+	return 0;
+}
+
+int _popup_visible(struct appdata *data)
+{
+	return visible;
+}
+
+double _get_slider_value(void *data)
+{
+	return slider;
+}
+
+int _set_icon(void *data, int val)
+{
+	return 0;
+}
+
+void _play_sound(int type)
+{
+}
+
+void _play_vib(void)
+{
+}
+
+int _get_sound_status(void)
+{
+	return sound;
+}
+
+void _set_sound_status(int on)
+{
+	sound = on;
+}
+
+static const int keys[] = {
+	CONTROL_KEY_UP, CONTROL_KEY_DOWN, CONTROL_KEY_OTHER,
+};
+
+/* a launch with or without a LONG_PRESS bundle of a held key */
+static void _launch(void)
+{
+	int r = _rnd() % 4;
+
+	if (!visible) {
+		ad.type = launch_types[_rnd() % (sizeof(launch_types) / sizeof(launch_types[0]))];
+		ad.step = _level_max(ad.type);
+		_level_get(ad.type, &slider);
+		visible = 1;
+	}
+	if (r == 1)
+		_control_launch(&ad, CONTROL_KEY_UP);
+	else if (r == 2)
+		_control_launch(&ad, CONTROL_KEY_DOWN);
+	else
+		_control_launch(&ad, CONTROL_KEY_OTHER);
+}
+
+static void _touch_move(int val)
+{
+	slider = val;
+	if (_control_touch_move(&ad))
+		slider = 0;
+}
+
+static void _ug_open(void)
+{
+	if (_control_ug_open(&ad))
+		ad.ug = (ui_gadget_h)&ad;
+}
+
+static void _ug_close(void)
+{
+	if (ad.ug == NULL)
+		return;
+	ad.ug = NULL;
+	_input_event(&ad, INPUT_EV_UG_CLOSE);
+	_close_volume(&ad);
+}
+
+static void _notify(void)
+{
+	int type = _rnd() % VOLUME_TYPE_MAX;
+
+	external = 1;
+	_backend_set_level(type, _rnd() % (_level_max(type) + 1));
+	external = 0;
+}
+
+static void _input(int ev)
+{
+	inputs++;
+	window_budget++;
+	switch (ev) {
+	case EV_KEY_DOWN:
+	case EV_KEY_UP:
+		if (!visible)
+			break;
+		if (ev == EV_KEY_DOWN)
+			_control_key_down(&ad, keys[_rnd() % 3]);
+		else
+			_control_key_up(&ad, keys[_rnd() % 3]);
+		break;
+	case EV_TOUCH_START:
+		if (visible && ad.ug == NULL)
+			_control_touch_start(&ad);
+		break;
+	case EV_TOUCH_MOVE:
+		if (visible && ad.ug == NULL)
+			_touch_move(_rnd() % (ad.step + 1));
+		break;
+	case EV_TOUCH_STOP:
+		if (visible && ad.ug == NULL)
+			_control_touch_stop(&ad);
+		break;
+	case EV_LAUNCH:
+		if (ad.ug == NULL)
+			_launch();
+		break;
+	case EV_CLICK:
+		if (visible && ad.ug == NULL)
+			_close_volume(&ad);
+		break;
+	case EV_UG_OPEN:
+		if (visible && ad.ug == NULL)
+			_ug_open();
+		break;
+	case EV_UG_CLOSE:
+		_ug_close();
+		break;
+	case EV_NOTIFY:
+		_notify();
+		break;
+	case EV_MUTE:
+		sound = 0;
+		break;
+	}
+}
+
+static int _owned(Ecore_Timer *t)
+{
+	if (t == NULL)
+		return 0;
+	if (!_vclock_is_live(t))
+		_fail("appdata holds a timer that is gone");
+	return 1;
+}
+
+static void _check(void)
+{
+	Ecore_Timer *own[] = {
+		ad.ptimer, ad.stimer, ad.sutimer, ad.sdtimer,
+		ad.lutimer, ad.ldtimer,
+	};
+	int i, j, n = 0, val, cur, max;
+
+	for (i = 0; i < sizeof(own) / sizeof(own[0]); i++) {
+		n += _owned(own[i]);
+		for (j = 0; j < i; j++) {
+			if (own[i] && own[i] == own[j])
+				_fail("two appdata fields hold one timer");
+		}
+	}
+	if (n != _vclock_live())
+		_fail("a timer is live without an owner");
+	if (_vclock_errors())
+		_fail("timer deleted twice or timer table full");
+
+	if (!visible && (n || ad.input_mode != INPUT_IDLE))
+		_fail("hidden popup still busy");
+	if (ad.stimer && ad.input_mode != INPUT_TOUCH)
+		_fail("slider timer outside touch");
+
+	for (i = 0; i < VOLUME_TYPE_MAX; i++) {
+		max = _level_max(i);
+		if (_level_get(i, &val) < 0 || _backend_get_level(i, &cur) < 0)
+			_fail("level unreadable");
+		if (val < 0 || val > max)
+			_fail("level out of range");
+		if (val != cur)
+			_fail("cached level differs from the backend");
+	}
+
+	if ((long)_vclock_now() != (long)window) {
+		window = (long)_vclock_now();
+		window_writes = 0;
+		window_budget = 0;
+		window_fired = _vclock_fired();
+	}
+	if (window_writes > window_budget + (_vclock_fired() - window_fired))
+		_fail("more writes than inputs and timer callbacks");
+}
+
+int main(int argc, char *argv[])
+{
+	struct timespec t0, t1;
+	unsigned long n = argc > 1 ? strtoul(argv[1], NULL, 0) : EVENT_DEFAULT;
+	double wall;
+	int i;
+
+	seed = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+	rnd_state = seed * 2654435761u + 1;
+
+	/* the handlers only look whether there is a slider */
+	ad.sl = (Evas_Object *)&ad;
+
+	if (_backend_init("sim") < 0) {
+		fprintf(stderr, "no sim backend\n");
+		return 2;
+	}
+	for (i = 0; i < VOLUME_TYPE_MAX; i++)
+		_backend_add_callback(i, _changed, (void *)(intptr_t)i);
+	for (i = 0; i < VOLUME_TYPE_MAX; i++)
+		_level_read(i, &slider);
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (events = 0; events < n; events++) {
+		/* mostly quick input, now and then long holds and timeouts */
+		if (_rnd() % 8 == 0)
+			_vclock_run(_vclock_now() + (_rnd() % 4000) / 1000.0);
+		else
+			_vclock_run(_vclock_now() + (_rnd() % 300) / 1000.0);
+		_drain();
+		_check();
+
+		_input(_pick(weight, EV_MAX));
+		_drain();
+		_check();
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	wall = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+	printf("seed %lu inputs %lu timer callbacks %lu writes %lu virtual %.0fs wall %.2fs\n",
+			seed, inputs, _vclock_fired(), writes, _vclock_now(), wall);
+	printf("%.0f events/sec\n", (inputs + _vclock_fired()) / (wall > 0 ? wall : 1e-9));
+	return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/*
+ * Seqlock check for the published volume state.
+ *
+ * One thread publishes type 0 through the writer in src/_state.c with
+ * every field set to the same counter, the others read it back through
+ * the reader in src/volume_state.c. A snapshot whose fields disagree,
+ * or whose generation does not match the counter, is torn. Then the
+ * writer restarts on the live segment, which must move every sequence
+ * counter forward instead of back to zero.
+ *
+ *  volume-state-stress [publishes] [readers]
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "volume_state.h"
+#include "_state.h"
+
+#define PUBLISH_DEFAULT	2000000
+#define READER_MAX	8
+
+static volatile int done;
+
+struct reader {
+	pthread_t th;
+	unsigned long reads;
+	unsigned long busy;
+	unsigned long torn;
+};
+
+static void *_write(void *data)
+{
+	long n = (long)data;
+	long i;
+
+	for (i = 1; i <= n; i++)
+		_state_publish(0, i, i, i, i);
+	done = 1;
+	return NULL;
+}
+
+static void *_read(void *data)
+{
+	struct reader *r = data;
+	struct volume_state st;
+	int last = 0;
+	int ret;
+
+	while (!done) {
+		ret = volume_state_read(0, &st);
+		if (ret == -EAGAIN) {
+			r->busy++;
+			continue;
+		}
+		if (ret < 0)
+			continue;
+		r->reads++;
+		if (st.step != st.level || st.route != st.level
+				|| st.mute != st.level
+				|| st.generation != (unsigned int)st.level
+				|| st.level < last) {
+			if (r->torn++ == 0)
+				fprintf(stderr, "torn: level %d step %d route %d mute %d generation %u\n",
+						st.level, st.step, st.route, st.mute, st.generation);
+		}
+		last = st.level;
+	}
+	return NULL;
+}
+
+/* a reader that sampled seq before the restart must not validate after */
+static int _check_restart(void)
+{
+	const struct volume_state_shm *m;
+	struct volume_state st;
+	unsigned int before;
+	int fd, ret = 0;
+
+	fd = shm_open(VOLUME_STATE_SHM_NAME, O_RDONLY, 0);
+	if (fd < 0)
+		return -1;
+	m = mmap(NULL, sizeof(*m), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (m == MAP_FAILED)
+		return -1;
+
+	before = m->entry[0].seq;
+	_state_fini();
+	if (_state_init() < 0)
+		ret = -1;
+	else if (m->entry[0].seq <= before || (m->entry[0].seq & 1)) {
+		fprintf(stderr, "restart: seq %u -> %u\n", before, m->entry[0].seq);
+		ret = -1;
+	} else if (volume_state_read(0, &st) < 0 || st.generation != 0
+			|| _state_get(0, &st) == 0) {
+		fprintf(stderr, "restart: entry not cleared\n");
+		ret = -1;
+	}
+	munmap((void *)m, sizeof(*m));
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	struct reader rd[READER_MAX] = { { 0, }, };
+	pthread_t wr;
+	long n = argc > 1 ? atol(argv[1]) : PUBLISH_DEFAULT;
+	int readers = argc > 2 ? atoi(argv[2]) : 2;
+	unsigned long reads = 0, busy = 0, torn = 0;
+	int i, restart;
+
+	if (readers < 1 || readers > READER_MAX || n < 1) {
+		fprintf(stderr, "usage: %s [publishes] [readers 1..%d]\n", argv[0], READER_MAX);
+		return 2;
+	}
+
+	shm_unlink(VOLUME_STATE_SHM_NAME);
+	if (_state_init() < 0 || volume_state_attach() < 0) {
+		fprintf(stderr, "cannot map %s\n", VOLUME_STATE_SHM_NAME);
+		return 2;
+	}
+
+	for (i = 0; i < readers; i++)
+		pthread_create(&rd[i].th, NULL, _read, &rd[i]);
+	pthread_create(&wr, NULL, _write, (void *)n);
+	pthread_join(wr, NULL);
+	for (i = 0; i < readers; i++) {
+		pthread_join(rd[i].th, NULL);
+		reads += rd[i].reads;
+		busy += rd[i].busy;
+		torn += rd[i].torn;
+	}
+
+	restart = _check_restart();
+
+	volume_state_detach();
+	_state_fini();
+	shm_unlink(VOLUME_STATE_SHM_NAME);
+
+	printf("publishes %ld readers %d reads %lu busy %lu torn %lu restart %s\n",
+			n, readers, reads, busy, torn, restart < 0 ? "failed" : "ok");
+	return torn || restart < 0 ? 1 : 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <stdio.h>
+
+#include "vclock.h"
+
+#define VCLOCK_TIMER_MAX 64
+
+struct vtimer {
+	double at;
+	double in;
+	Ecore_Task_Cb cb;
+	void *data;
+	unsigned long seq;	/* add order, breaks ties and marks reuse */
+	int live;
+};
+
+static struct vtimer timers[VCLOCK_TIMER_MAX];
+static double now;
+static unsigned long seq;
+static unsigned long fired;
+static int live;
+static int errors;
+
+Ecore_Timer *_vclock_add(double in, Ecore_Task_Cb cb, const void *data)
+{
+	struct vtimer *t;
+	int i;
+
+	for (i = 0; i < VCLOCK_TIMER_MAX; i++) {
+		if (!timers[i].live)
+			break;
+	}
+	if (i == VCLOCK_TIMER_MAX) {
+		fprintf(stderr, "vclock: more than %d timers, leaking\n", VCLOCK_TIMER_MAX);
+		errors++;
+		return NULL;
+	}
+
+	t = &timers[i];
+	t->in = in > 0.0 ? in : VCLOCK_FRAME;
+	t->at = now + t->in;
+	t->cb = cb;
+	t->data = (void *)data;
+	t->seq = ++seq;
+	t->live = 1;
+	live++;
+	return (Ecore_Timer *)t;
+}
+
+void *_vclock_del(Ecore_Timer *timer)
+{
+	struct vtimer *t = (struct vtimer *)timer;
+
+	if (t < timers || t >= timers + VCLOCK_TIMER_MAX || !t->live) {
+		fprintf(stderr, "vclock: deleting a timer that is not live\n");
+		errors++;
+		return NULL;
+	}
+	t->live = 0;
+	live--;
+	return t->data;
+}
+
+/* fire every timer due until the given time, earliest first */
+void _vclock_run(double until)
+{
+	struct vtimer *t;
+	unsigned long s;
+	int i;
+
+	for (;;) {
+		t = NULL;
+		for (i = 0; i < VCLOCK_TIMER_MAX; i++) {
+			if (!timers[i].live || timers[i].at > until)
+				continue;
+			if (t == NULL || timers[i].at < t->at
+					|| (timers[i].at == t->at && timers[i].seq < t->seq))
+				t = &timers[i];
+		}
+		if (t == NULL)
+			break;
+
+		now = t->at;
+		s = t->seq;
+		fired++;
+		if (t->cb(t->data) == ECORE_CALLBACK_RENEW) {
+			if (t->live && t->seq == s)
+				t->at = now + t->in;
+		} else if (t->live && t->seq == s) {
+			t->live = 0;
+			live--;
+		}
+	}
+	now = until;
+}
+
+double _vclock_now(void)
+{
+	return now;
+}
+
+int _vclock_live(void)
+{
+	return live;
+}
+
+int _vclock_is_live(Ecore_Timer *timer)
+{
+	struct vtimer *t = (struct vtimer *)timer;
+	return t >= timers && t < timers + VCLOCK_TIMER_MAX && t->live;
+}
+
+unsigned long _vclock_fired(void)
+{
+	return fired;
+}
+
+int _vclock_errors(void)
+{
+	return errors;
+}
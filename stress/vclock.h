@@ -0,0 +1,43 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ * 
+ * Licensed under the Flora License, Version 1.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.tizenopensource.org/license
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef __VOLUME_VCLOCK_H__
+#define __VOLUME_VCLOCK_H__
+
+/*
+ * Virtual clock behind the TIMER_ADD/TIMER_DEL hook of src/volume.h.
+ * The stress targets build with -DTIMER_ADD=_vclock_add
+ * -DTIMER_DEL=_vclock_del and force include this header, so every popup
+ * timer lands here and fires only when _vclock_run() moves time on.
+ */
+
+#include <Ecore.h>
+
+#define VCLOCK_FRAME (1.0 / 60.0)	/* a 0.0 timer fires once per frame */
+
+Ecore_Timer *_vclock_add(double in, Ecore_Task_Cb cb, const void *data);
+void *_vclock_del(Ecore_Timer *timer);
+void _vclock_run(double until);
+double _vclock_now(void);
+int _vclock_live(void);
+int _vclock_is_live(Ecore_Timer *timer);
+unsigned long _vclock_fired(void);
+int _vclock_errors(void);
+
+#endif
+/* __VOLUME_VCLOCK_H__ */